@@ -0,0 +1,30 @@
+#ifndef INCLUDE_GUARD_5B0E2A57_9C3D_4E51_B8A4_6F2D1C7E9A30
+#define INCLUDE_GUARD_5B0E2A57_9C3D_4E51_B8A4_6F2D1C7E9A30
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Returns the fastest time in nanoseconds per operation of several runs of f, which performs
+// operations operations each time
+template <typename Function>
+double time_per_operation(std::size_t operations, Function f) {
+	auto best = std::chrono::nanoseconds::max();
+	for(int run = 0; run < 7; ++run) {
+		auto const start = std::chrono::steady_clock::now();
+		f();
+		auto const time = std::chrono::steady_clock::now() - start;
+		best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+	}
+	return static_cast<double>(best.count()) / operations;
+}
+
+inline void report(std::string const& name, double baseline, double time) {
+	std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+	          << std::setprecision(2) << std::setw(8) << baseline << " ns"
+	          << std::setw(8) << time << " ns" << std::setw(8) << baseline / time << "x\n";
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "ez/compact_interval.hpp"
+#include "benchmark.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Times counting how many of intervals contain each of values, over an array that is larger than
+// the caches so that the size of each interval matters
+template <typename Interval>
+double run(std::vector<Interval> const& intervals, std::vector<double> const& values) {
+	std::size_t count = 0;
+	auto const time = time_per_operation(intervals.size(), [&] {
+		for(std::size_t i = 0; i < intervals.size(); ++i) {
+			count += contains(intervals[i], values[i & (values.size() - 1)]);
+		}
+	});
+
+	// Use the result so that the loop is not removed
+	if(count == 123) {
+		std::cout << count;
+	}
+	return time;
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::uniform_real_distribution<double> value{-1.0, 1.0};
+	std::bernoulli_distribution open{0.5};
+	std::size_t const n = 1 << 23;
+	std::vector<ez::interval<double>> intervals;
+	std::vector<ez::compact_interval<double>> compact;
+	intervals.reserve(n);
+	compact.reserve(n);
+	while(intervals.size() < n) {
+		auto const a = value(engine);
+		auto const b = a + (value(engine) + 1.0) / 4.0;
+		intervals.emplace_back(a, b, open(engine), open(engine));
+		compact.emplace_back(intervals.back());
+	}
+
+	std::vector<double> values(1 << 10);
+	for(auto& v : values) {
+		v = value(engine);
+	}
+
+	std::cout << "Bytes per interval: interval<double> " << sizeof(intervals[0])
+	          << ", compact_interval<double> " << sizeof(compact[0]) << "\n";
+	std::cout << "Time per operation of contains                  interval  compact\n";
+	report("contains", run(intervals, values), run(compact, values));
+}
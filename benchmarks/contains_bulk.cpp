@@ -0,0 +1,57 @@
+#include "ez/contains_bulk.hpp"
+#include "benchmark.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename T>
+void run(std::string const& name, ez::interval<T> const& r, std::vector<T> const& values) {
+	auto const n = values.size();
+	std::vector<std::uint64_t> bits(n / 64);
+	std::uint64_t check = 0;
+
+	auto const loop = time_per_operation(n, [&] {
+		for(std::size_t w = 0; w < n / 64; ++w) {
+			std::uint64_t word = 0;
+			for(std::size_t j = 0; j < 64; ++j) {
+				word |= static_cast<std::uint64_t>(ez::contains(r, values[64 * w + j])) << j;
+			}
+			bits[w] = word;
+		}
+		check += bits[n / 128];
+	});
+
+	auto const bulk = time_per_operation(n, [&] {
+		ez::contains_bulk(r, values.data(), n, bits.data());
+		check += bits[n / 128];
+	});
+
+	// Use the result so that the loops are not removed
+	if(check == 123) {
+		std::cout << check;
+	}
+	report(name, loop, bulk);
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::uniform_int_distribution<int> value{-1000, 1000};
+	std::size_t const n = 1 << 16;
+	std::vector<double> doubles;
+	std::vector<std::int32_t> ints;
+	while(doubles.size() < n) {
+		auto const x = value(engine);
+		doubles.push_back(x);
+		ints.push_back(x);
+	}
+
+	std::cout << "Time per value                             contains       bulk\n";
+	run("double [-500, 500)", ez::interval<double>{-500.0, 500.0, ez::right_open}, doubles);
+	run("int32_t (-500, 500]", ez::interval<std::int32_t>{-500, 500, ez::left_open}, ints);
+}
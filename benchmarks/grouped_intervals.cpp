@@ -0,0 +1,71 @@
+#include "ez/grouped_intervals.hpp"
+#include "benchmark.hpp"
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Times f for each of values, where f tests every interval
+template <typename Function>
+double run(std::size_t n, std::vector<double> const& values, Function f) {
+	std::size_t count = 0;
+	auto const time = time_per_operation(n * values.size(), [&] {
+		for(auto const v : values) {
+			count += f(v);
+		}
+	});
+
+	// Use the result so that the loop is not removed
+	if(count == 123) {
+		std::cout << count;
+	}
+	return time;
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::uniform_real_distribution<double> value{-1.0, 1.0};
+	std::uniform_int_distribution<int> open{0, 3};
+	std::size_t const n = 1 << 16;
+	std::vector<ez::interval<double>> intervals;
+	while(intervals.size() < n) {
+		auto const a = value(engine);
+		auto const b = a + (value(engine) + 1.0) / 4.0;
+		intervals.emplace_back(a, b, static_cast<ez::openness>(open(engine)));
+	}
+
+	std::vector<double> values(64);
+	for(auto& v : values) {
+		v = value(engine);
+	}
+
+	ez::grouped_intervals<double> const grouped{intervals.data(), intervals.size()};
+	std::unique_ptr<bool[]> hits{new bool[n]};
+
+	std::cout << "Time per interval with random openness      interval  grouped\n";
+	report("count_containing",
+	       run(n, values, [&](double v) {
+	           std::size_t count = 0;
+	           for(auto const& r : intervals) {
+	               count += contains(r, v);
+	           }
+	           return count;
+	       }),
+	       run(n, values, [&](double v) { return grouped.count_containing(v); }));
+	report("contains",
+	       run(n, values, [&](double v) {
+	           for(std::size_t i = 0; i < n; ++i) {
+	               hits[i] = contains(intervals[i], v);
+	           }
+	           return hits[n / 2];
+	       }),
+	       run(n, values, [&](double v) {
+	           grouped.contains(v, hits.get());
+	           return hits[n / 2];
+	       }));
+}
@@ -0,0 +1,69 @@
+#include "ez/interval.hpp"
+#include "benchmark.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Random intervals of double, with random openness, that do not contain zero when divisors is true
+std::vector<ez::interval<double>> random_intervals(std::size_t n, bool divisors,
+                                                   std::mt19937& engine) {
+	std::uniform_real_distribution<double> value{-100.0, 100.0};
+	std::uniform_int_distribution<int> open{0, 3};
+	std::vector<ez::interval<double>> result;
+	while(result.size() < n) {
+		auto a = value(engine);
+		auto b = value(engine);
+		if(b < a) {
+			std::swap(a, b);
+		}
+		if(!divisors || a > 0.0 || b < 0.0) {
+			result.push_back(ez::interval<double>{a, b, static_cast<ez::openness>(open(engine))});
+		}
+	}
+	return result;
+}
+
+template <typename Function>
+double run(std::vector<ez::interval<double>> const& l, std::vector<ez::interval<double>> const& r,
+           Function f) {
+	auto sum = 0.0;
+	auto const time = time_per_operation(l.size(), [&] {
+		for(std::size_t i = 0; i < l.size(); ++i) {
+			auto x = l[i];
+			f(x, r[i]);
+			sum += x.lower() + x.upper() + x.left_open();
+		}
+	});
+
+	// Use the result so that the loop is not removed
+	if(sum == 0.123) {
+		std::cout << sum;
+	}
+	return time;
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::size_t const n = 1 << 20;
+	auto const l = random_intervals(n, false, engine);
+	auto const r = random_intervals(n, false, engine);
+	auto const d = random_intervals(n, true, engine);
+
+	std::cout << "Time per operation of ez::interval<double>      general    fast\n";
+	report("operator*=",
+	       run(l, r, ez::detail::general_multiply<double>),
+	       run(l, r, [](ez::interval<double>& a, ez::interval<double> const& b){ a *= b; }));
+	report("operator/=",
+	       run(l, d, [](ez::interval<double>& a, ez::interval<double> const& b){
+	           if(contains(ez::make_closed(b), 0.0)) {
+	               throw ez::divide_by_zero{};
+	           }
+	           ez::detail::general_divide(a, b);
+	       }),
+	       run(l, d, [](ez::interval<double>& a, ez::interval<double> const& b){ a /= b; }));
+}
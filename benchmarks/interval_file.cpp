@@ -0,0 +1,81 @@
+#include "ez/interval_file.hpp"
+#include "benchmark.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef ez::interval<double> interval;
+
+// Reads every interval of the file at path into a vector, as a loader without a mappable format
+// would have to
+std::vector<interval> read(std::string const& path) {
+	std::ifstream in{path, std::ios::binary};
+	std::vector<char> bytes{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+	ez::interval_view<interval> const view{bytes.data(), bytes.size()};
+	std::vector<interval> intervals;
+	intervals.reserve(view.size());
+	for(std::size_t i = 0; i < view.size(); ++i) {
+		intervals.push_back(view[i]);
+	}
+	return intervals;
+}
+
+// Times f, which opens the file of n intervals and returns the sum of the lower bounds of the
+// first few
+template <typename Function>
+double run(std::size_t n, Function f) {
+	auto sum = 0.0;
+	auto const time = time_per_operation(n, [&] {
+		sum += f();
+	});
+
+	// Use the result so that the loop is not removed
+	if(sum == 0.123) {
+		std::cout << sum;
+	}
+	return time;
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::uniform_real_distribution<double> value{-1.0, 1.0};
+	std::size_t const n = 1 << 22;
+	std::vector<interval> intervals;
+	while(intervals.size() < n) {
+		auto const a = value(engine);
+		intervals.emplace_back(a, a + 1.0, static_cast<ez::openness>(intervals.size() % 4));
+	}
+
+	std::string const path = "interval_file_benchmark.bin";
+	{
+		std::ofstream out{path, std::ios::binary};
+		ez::write_intervals(out, intervals.data(), intervals.size());
+	}
+
+	std::cout << "Time per interval in the file to open it             read  mapped\n";
+	report("open and read 1000 intervals", run(n, [&] {
+		auto const v = read(path);
+		auto sum = 0.0;
+		for(std::size_t i = 0; i < 1000; ++i) {
+			sum += v[i].lower();
+		}
+		return sum;
+	}), run(n, [&] {
+		ez::mapped_intervals<interval> const m{path};
+		auto sum = 0.0;
+		for(std::size_t i = 0; i < 1000; ++i) {
+			sum += m[i].lower();
+		}
+		return sum;
+	}));
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,67 @@
+#include "ez/rounding.hpp"
+#include "benchmark.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Widens a result computed with rounding to nearest by one unit in the last place on each side
+ez::interval<double> widen(ez::interval<double> const& r) {
+	auto const inf = std::numeric_limits<double>::infinity();
+	return {std::nextafter(r.lower(), -inf), std::nextafter(r.upper(), inf),
+	        r.left_open(), r.right_open()};
+}
+
+template <typename Function>
+double run(std::vector<ez::interval<double>> const& l, std::vector<ez::interval<double>> const& r,
+           Function f) {
+	auto sum = 0.0;
+	auto const time = time_per_operation(l.size(), [&] {
+		for(std::size_t i = 0; i < l.size(); ++i) {
+			auto const x = f(l[i], r[i]);
+			sum += x.lower() + x.upper();
+		}
+	});
+
+	// Use the result so that the loop is not removed
+	if(sum == 0.123) {
+		std::cout << sum;
+	}
+	return time;
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::uniform_real_distribution<double> value{-100.0, 100.0};
+	std::size_t const n = 1 << 20;
+	std::vector<ez::interval<double>> l;
+	std::vector<ez::interval<double>> r;
+	while(l.size() < n) {
+		auto const a = value(engine);
+		auto const b = value(engine);
+		l.push_back(ez::interval<double>{std::min(a, b), std::max(a, b), ez::closed});
+		r.push_back(ez::interval<double>{std::min(a, b) - 1.0, std::max(a, b), ez::closed});
+	}
+
+	typedef ez::interval<double> const& arg;
+	auto const add_nextafter = run(l, r, [](arg a, arg b){ return widen(a + b); });
+	auto const multiply_nextafter = run(l, r, [](arg a, arg b){ return widen(a * b); });
+
+	auto add_outward = 0.0;
+	auto multiply_outward = 0.0;
+	{
+		ez::outward_rounding rounding;
+		add_outward = run(l, r, [&rounding](arg a, arg b){ return rounding.add(a, b); });
+		multiply_outward = run(l, r, [&rounding](arg a, arg b){ return rounding.multiply(a, b); });
+	}
+
+	std::cout << "Time per operation of ez::interval<double>     nextafter outward\n";
+	report("add", add_nextafter, add_outward);
+	report("multiply", multiply_nextafter, multiply_outward);
+}
@@ -0,0 +1,62 @@
+#include "ez/partition_index.hpp"
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+void run(std::string const& name, int bins, std::vector<double> const& values) {
+	std::vector<ez::ropen_interval<double>> intervals;
+	for(int i = 0; i < bins; ++i) {
+		intervals.push_back(ez::make_interval[1.0 * i](1.0 * i + 1.0));
+	}
+	ez::partition_index<double> const index(intervals.begin(), intervals.end());
+	std::vector<std::size_t> out(values.size());
+	std::size_t check = 0;
+
+	auto const linear = time_per_operation(values.size(), [&] {
+		for(std::size_t i = 0; i < values.size(); ++i) {
+			auto const x = values[i];
+			out[i] = static_cast<std::size_t>(
+			  std::find_if(intervals.begin(), intervals.end(),
+			               [x](ez::ropen_interval<double> const& r){ return contains(r, x); }) -
+			  intervals.begin());
+		}
+		check += out[values.size() / 2];
+	});
+
+	auto const indexed = time_per_operation(values.size(), [&] {
+		index.buckets(values.data(), values.size(), out.data());
+		check += out[values.size() / 2];
+	});
+
+	// Use the result so that the loops are not removed
+	if(check == 123) {
+		std::cout << check;
+	}
+	report(name, linear, indexed);
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::vector<double> values;
+	std::uniform_real_distribution<double> value{0.0, 1.0};
+	while(values.size() < (1 << 18)) {
+		values.push_back(value(engine));
+	}
+
+	std::cout << "Time per value" << std::string(26, ' ') << "  find_if      index\n";
+	for(int bins : {8, 64, 1024}) {
+		std::vector<double> scaled(values);
+		for(auto& x : scaled) {
+			x *= bins;
+		}
+		run(std::to_string(bins) + " bins", bins, scaled);
+	}
+}
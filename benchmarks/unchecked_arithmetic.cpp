@@ -0,0 +1,95 @@
+#include "ez/unchecked.hpp"
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef std::pair<double, double> pair;
+typedef ez::closed_interval<double> closed;
+
+double lower(pair const& r) {
+	return r.first;
+}
+
+double upper(pair const& r) {
+	return r.second;
+}
+
+double lower(closed const& r) {
+	return r.lower();
+}
+
+double upper(closed const& r) {
+	return r.upper();
+}
+
+pair add(pair const& l, pair const& r) {
+	return {l.first + r.first, l.second + r.second};
+}
+
+pair multiply(pair const& l, pair const& r) {
+	double const a = l.first * r.first;
+	double const b = l.first * r.second;
+	double const c = l.second * r.first;
+	double const d = l.second * r.second;
+	return {std::min(std::min(a, b), std::min(c, d)), std::max(std::max(a, b), std::max(c, d))};
+}
+
+// Times f on each pair of neighbouring elements of values, where Interval is either closed or a
+// pair holding the same bounds
+template <typename Interval, typename Function>
+double run(std::vector<Interval> const& values, Function f) {
+	auto sum = 0.0;
+	auto const time = time_per_operation(values.size() - 1, [&] {
+		for(std::size_t i = 1; i < values.size(); ++i) {
+			auto const r = f(values[i - 1], values[i]);
+			sum += lower(r) + upper(r);
+		}
+	});
+
+	// Use the result so that the loop is not removed
+	if(sum == 0.123) {
+		std::cout << sum;
+	}
+	return time;
+}
+
+}
+
+int main() {
+	std::mt19937 engine{1};
+	std::uniform_real_distribution<double> value{-1.0, 1.0};
+	std::size_t const n = 1 << 16;
+	std::vector<pair> pairs;
+	std::vector<closed> intervals;
+	while(pairs.size() < n) {
+		auto const a = value(engine);
+		auto const b = a + (value(engine) + 1.0) / 1024.0;
+		pairs.emplace_back(a, b);
+		intervals.emplace_back(a, b);
+	}
+
+	std::cout << "Time per operation of closed_interval<double>  std::pair  interval\n";
+	auto const pair_add = run(pairs, [](pair const& l, pair const& r){ return add(l, r); });
+	report("operator+",
+	       pair_add, run(intervals, [](closed const& l, closed const& r){ return l + r; }));
+	report("unchecked_add",
+	       pair_add, run(intervals, [](closed const& l, closed const& r){
+	           return ez::unchecked_add(l, r);
+	       }));
+
+	auto const pair_multiply = run(pairs, [](pair const& l, pair const& r){
+		return multiply(l, r);
+	});
+	report("operator*",
+	       pair_multiply, run(intervals, [](closed const& l, closed const& r){ return l * r; }));
+	report("unchecked_mul",
+	       pair_multiply, run(intervals, [](closed const& l, closed const& r){
+	           return ez::unchecked_mul(l, r);
+	       }));
+}
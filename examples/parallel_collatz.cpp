@@ -0,0 +1,36 @@
+#include "ez/interval.hpp"
+#include "ez/parallel.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+int main() {
+	auto next_collatz = [](long long n){ return (n % 2) ? 3 * n + 1 : n / 2; };
+	auto stopping_time = [next_collatz](long long n){
+		int i = 0;
+		while(n != 1) {
+			n = next_collatz(n);
+			++i;
+		}
+		return i;
+	};
+
+	// Values are computed in parallel but written in order
+	std::cout << "Stopping time for the Collatz conjecture\n";
+	ez::parallel_transform(ez::make_interval[1](101),
+	                       std::ostream_iterator<int>(std::cout, ", "),
+	                       stopping_time);
+	std::cout << '\n';
+
+	// The stopping time varies a lot between numbers, so let the thread pool balance the work
+	std::vector<int> times(1000000);
+	ez::parallel_for(ez::indices(times), [&](std::size_t i) {
+		times[i] = stopping_time(static_cast<long long>(i) + 1);
+	});
+
+	auto const longest = std::max_element(times.begin(), times.end());
+	std::cout << "Longest stopping time below " << times.size() + 1 << " is " << *longest
+	          << " for " << (longest - times.begin()) + 1 << '\n';
+}
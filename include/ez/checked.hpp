@@ -0,0 +1,342 @@
+/******************************************************************//**
+ * \file   checked.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_A78424EA_DC55_4A62_868C_37A1088B2122
+#define INCLUDE_GUARD_A78424EA_DC55_4A62_868C_37A1088B2122
+
+#include "ez/interval.hpp"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ez {
+
+/** The errors that the functions in this file return instead of throwing. Each corresponds to the
+ *  exception of the same name. */
+enum class errc {
+	empty_interval,
+	divide_by_zero
+};
+
+/** Holds either a value of type T or the errc explaining why there is no value.
+ *
+ *  This is returned by try_interval and the checked_ arithmetic functions, which never throw
+ *  empty_interval or divide_by_zero. Only value() throws, and then only if there is no value.
+ *
+ *  \code
+ *  auto r = ez::checked_div(ez::make_interval[1][2], ez::make_interval[-1][1]);
+ *  assert(!r && r.error() == ez::errc::divide_by_zero);
+ *  \endcode */
+template <typename T>
+class result {
+public:
+	typedef T value_type;
+
+	result(T const& value) noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: m_value(value)
+	, m_has_value{true} {
+	}
+
+	result(T&& value) noexcept(std::is_nothrow_move_constructible<T>::value)
+	: m_value(std::move(value))
+	, m_has_value{true} {
+	}
+
+	result(errc error) noexcept
+	: m_error{error}
+	, m_has_value{false} {
+	}
+
+	result(result const& other) noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: m_error{errc::empty_interval}
+	, m_has_value{false} {
+		construct(other);
+	}
+
+	result(result&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	: m_error{errc::empty_interval}
+	, m_has_value{false} {
+		construct(std::move(other));
+	}
+
+	result& operator=(result const& other) {
+		if(this != &other) {
+			destroy();
+			construct(other);
+		}
+		return *this;
+	}
+
+	result& operator=(result&& other) {
+		if(this != &other) {
+			destroy();
+			construct(std::move(other));
+		}
+		return *this;
+	}
+
+	~result() {
+		destroy();
+	}
+
+	bool has_value() const noexcept {
+		return m_has_value;
+	}
+
+	explicit operator bool() const noexcept {
+		return m_has_value;
+	}
+
+	/** Returns the value. The behaviour is undefined if there is no value. */
+	T const& operator*() const noexcept {
+		return m_value;
+	}
+
+	T& operator*() noexcept {
+		return m_value;
+	}
+
+	T const* operator->() const noexcept {
+		return &m_value;
+	}
+
+	T* operator->() noexcept {
+		return &m_value;
+	}
+
+	/** Returns the value, or throws the exception corresponding to error() if there is no
+	 *  value. */
+	T const& value() const {
+		if(!m_has_value) {
+			raise();
+		}
+		return m_value;
+	}
+
+	/** Returns the value, or \a other if there is no value. */
+	T value_or(T const& other) const {
+		return m_has_value ? m_value : other;
+	}
+
+	/** Returns the error. The behaviour is undefined if there is a value. */
+	errc error() const noexcept {
+		return m_error;
+	}
+
+private:
+	template <typename Result>
+	void construct(Result&& other) {
+		if(other.m_has_value) {
+			::new(static_cast<void*>(&m_value)) T(std::forward<Result>(other).m_value);
+			m_has_value = true;
+		} else {
+			m_error = other.m_error;
+		}
+	}
+
+	void destroy() noexcept {
+		if(m_has_value) {
+			m_value.~T();
+			m_has_value = false;
+			m_error = errc::empty_interval;
+		}
+	}
+
+	[[noreturn]] void raise() const {
+		if(m_error == errc::divide_by_zero) {
+			EZ_THROW(divide_by_zero{});
+		}
+		EZ_THROW(empty_interval{});
+	}
+
+	union {
+		T m_value;
+		errc m_error;
+	};
+	bool m_has_value;
+};
+
+namespace detail {
+
+// to_interval converts r to an interval without checking that it is non-empty again
+template <typename Interval>
+interval<typename Interval::type> to_interval(Interval const& r) {
+	return {r.lower(), r.upper(), r.left_open(), r.right_open(), unchecked_tag{}};
+}
+
+}
+
+/** Returns the interval between \a lower and \a upper with the given openness, or
+ *  errc::empty_interval if it would be empty.
+ *
+ *  \code
+ *  assert(ez::try_interval(0, 3, false, true).value() == ez::make_interval[0](3));
+ *  assert(!ez::try_interval(3, 0, false, true));
+ *  \endcode */
+template <typename T>
+result<interval<T>> try_interval(T const& lower, T const& upper, bool left_open, bool right_open) {
+	if(!detail::valid(lower, upper, left_open, right_open)) {
+		return errc::empty_interval;
+	}
+	return interval<T>{lower, upper, left_open, right_open, detail::unchecked_tag{}};
+}
+
+/** Returns the interval between \a lower and \a upper with the openness \a o, or
+ *  errc::empty_interval if it would be empty. */
+template <typename T>
+result<interval<T>> try_interval(T const& lower, T const& upper, ez::openness o) {
+	return try_interval(lower, upper, (o & ez::left_open) != 0, (o & ez::right_open) != 0);
+}
+
+/** Returns the basic_interval between \a lower and \a upper, or errc::empty_interval if it would
+ *  be empty.
+ *
+ *  \code
+ *  auto r = ez::try_interval<false, true>(0, 3); // r.value() is [0, 3)
+ *  \endcode */
+template <bool LOpen, bool ROpen, typename T>
+result<basic_interval<T, LOpen, ROpen>> try_interval(T const& lower, T const& upper) {
+	if(!detail::valid(lower, upper, LOpen, ROpen)) {
+		return errc::empty_interval;
+	}
+	return basic_interval<T, LOpen, ROpen>{lower, upper, detail::unchecked_tag{}};
+}
+
+/***************************************************************************************************
+* Arithmetic that returns errors instead of throwing                                               *
+***************************************************************************************************/
+
+/* These give the same results as the arithmetic operators for interval, except that they return
+   errc::divide_by_zero or errc::empty_interval where the operators would throw divide_by_zero or
+   empty_interval. An empty result only happens when a bound is NaN. */
+
+template <typename Interval1, typename Interval2,
+          typename std::enable_if<is_interval<Interval1>::value &&
+                                  is_interval<Interval2>::value>::type* = nullptr>
+result<interval<typename Interval1::type>> checked_add(Interval1 const& l, Interval2 const& r) {
+	auto x = detail::to_interval(l);
+	if(!detail::try_add(x, r)) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+result<interval<typename Interval::type>>
+  checked_add(Interval const& l, typename Interval::difference_type const& d) {
+	auto x = detail::to_interval(l);
+	if(!detail::try_shift(x, d)) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+template <typename Interval1, typename Interval2,
+          typename std::enable_if<is_interval<Interval1>::value &&
+                                  is_interval<Interval2>::value>::type* = nullptr>
+result<interval<typename Interval1::type>> checked_sub(Interval1 const& l, Interval2 const& r) {
+	auto x = detail::to_interval(l);
+	if(!detail::try_subtract(x, r)) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+result<interval<typename Interval::type>>
+  checked_sub(Interval const& l, typename Interval::difference_type const& d) {
+	auto x = detail::to_interval(l);
+	if(!detail::try_assign(x, x.lower() - d, x.upper() - d, x.left_open(), x.right_open())) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+template <typename Interval1, typename Interval2,
+          typename std::enable_if<is_interval<Interval1>::value &&
+                                  is_interval<Interval2>::value>::type* = nullptr>
+result<interval<typename Interval1::type>> checked_mul(Interval1 const& l, Interval2 const& r) {
+	static_assert(std::is_same<typename Interval1::type, typename Interval2::type>::value,
+	              "Underlying types of intervals must be equal");
+	auto x = detail::to_interval(l);
+	if(!detail::try_multiply(x, detail::to_interval(r))) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+result<interval<typename Interval::type>>
+  checked_mul(Interval const& l, typename Interval::type const& d) {
+	auto x = detail::to_interval(l);
+	if(!detail::try_scale<false>(x, d)) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+template <typename Interval1, typename Interval2,
+          typename std::enable_if<is_interval<Interval1>::value &&
+                                  is_interval<Interval2>::value>::type* = nullptr>
+result<interval<typename Interval1::type>> checked_div(Interval1 const& l, Interval2 const& r) {
+	static_assert(std::is_same<typename Interval1::type, typename Interval2::type>::value,
+	              "Underlying types of intervals must be equal");
+	if(detail::divides_by_zero<typename Interval1::type>(r)) {
+		return errc::divide_by_zero;
+	}
+
+	auto x = detail::to_interval(l);
+	if(!detail::try_divide(x, detail::to_interval(r))) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+result<interval<typename Interval::type>>
+  checked_div(Interval const& l, typename Interval::type const& d) {
+	if(d == typename Interval::type{0}) {
+		return errc::divide_by_zero;
+	}
+
+	auto x = detail::to_interval(l);
+	if(!detail::try_scale<true>(x, d)) {
+		return errc::empty_interval;
+	}
+	return x;
+}
+
+}
+
+#endif
@@ -0,0 +1,324 @@
+/******************************************************************//**
+ * \file   chunk.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_9BD1A542_E6D4_4014_BFC1_BF08C1C0C13C
+#define INCLUDE_GUARD_9BD1A542_E6D4_4014_BFC1_BF08C1C0C13C
+
+#include "ez/direct_iterator.hpp"
+#include "ez/interval.hpp"
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ez {
+
+/** An invalid_chunk_size exception is thrown when trying to split an interval into chunks with a
+ *  size that is not positive. */
+struct invalid_chunk_size : std::runtime_error {
+	invalid_chunk_size()
+	: std::runtime_error{"Chunk size must be positive"} {
+	}
+};
+
+namespace detail {
+
+// advanced returns value advanced by n, wrapping around for the integral types
+template <typename T, typename Difference>
+T advanced(T value, Difference n) {
+	wrapping_advance(value, n, is_wrapping<T>{});
+	return value;
+}
+
+}
+
+template <typename T>
+class chunk_range;
+
+/** A random access iterator over the chunks of a chunk_range<T>, which dereferences to a
+ *  ropen_interval<T>. The chunk is stored inside the iterator, so the reference returned from
+ *  operator*() is invalidated when the iterator is changed or destroyed. */
+template <typename T>
+class chunk_iterator {
+public:
+	typedef ropen_interval<T> value_type;
+	typedef typename direct_iterator<T>::difference_type difference_type;
+	typedef value_type const* pointer;
+	typedef value_type const& reference;
+	typedef std::random_access_iterator_tag iterator_category;
+
+	chunk_iterator() noexcept(std::is_nothrow_default_constructible<T>::value)
+	: m_range{nullptr}
+	, m_index{}
+	, m_chunk{T{}, T{}, detail::unchecked_tag{}} {
+	}
+
+	chunk_iterator(chunk_range<T> const& range, difference_type index)
+	: m_range{&range}
+	, m_index{index}
+	, m_chunk{range.back()} {
+		update();
+	}
+
+	reference operator*() const noexcept {
+		return m_chunk;
+	}
+
+	pointer operator->() const noexcept {
+		return &m_chunk;
+	}
+
+	/** Returns the index of the chunk this iterator points to. */
+	difference_type index() const noexcept {
+		return m_index;
+	}
+
+	chunk_iterator<T>& operator++() {
+		// Each full chunk starts where the previous one ended, so only the last chunk needs to be
+		// looked up
+		if(++m_index < m_range->size() - 1) {
+			auto const lower = m_chunk.upper();
+			m_chunk = value_type{lower, detail::advanced(lower, m_range->chunk_size()),
+			                     detail::unchecked_tag{}};
+		} else {
+			update();
+		}
+		return *this;
+	}
+
+	chunk_iterator<T> operator++(int) {
+		auto const copy = *this;
+		++(*this);
+		return copy;
+	}
+
+	chunk_iterator<T>& operator--() {
+		--m_index;
+		update();
+		return *this;
+	}
+
+	chunk_iterator<T> operator--(int) {
+		auto const copy = *this;
+		--(*this);
+		return copy;
+	}
+
+	chunk_iterator<T>& operator+=(difference_type n) {
+		m_index += n;
+		update();
+		return *this;
+	}
+
+	chunk_iterator<T>& operator-=(difference_type n) {
+		m_index -= n;
+		update();
+		return *this;
+	}
+
+	chunk_iterator<T> operator-(difference_type n) const {
+		auto copy = *this;
+		copy -= n;
+		return copy;
+	}
+
+	value_type operator[](difference_type n) const {
+		return (*m_range)[m_index + n];
+	}
+
+private:
+	void update() {
+		if(m_index < m_range->size()) {
+			m_chunk = (*m_range)[m_index];
+		}
+	}
+
+	chunk_range<T> const* m_range;
+	difference_type m_index;
+	value_type m_chunk;
+};
+
+template <typename T>
+chunk_iterator<T> operator+(chunk_iterator<T> it, typename chunk_iterator<T>::difference_type n) {
+	it += n;
+	return it;
+}
+
+template <typename T>
+chunk_iterator<T> operator+(typename chunk_iterator<T>::difference_type n, chunk_iterator<T> it) {
+	it += n;
+	return it;
+}
+
+template <typename T>
+typename chunk_iterator<T>::difference_type operator-(chunk_iterator<T> const& lhs,
+                                                      chunk_iterator<T> const& rhs) noexcept {
+	return lhs.index() - rhs.index();
+}
+
+template <typename T>
+bool operator==(chunk_iterator<T> const& lhs, chunk_iterator<T> const& rhs) noexcept {
+	return lhs.index() == rhs.index();
+}
+
+template <typename T>
+bool operator!=(chunk_iterator<T> const& lhs, chunk_iterator<T> const& rhs) noexcept {
+	return lhs.index() != rhs.index();
+}
+
+template <typename T>
+bool operator<(chunk_iterator<T> const& lhs, chunk_iterator<T> const& rhs) noexcept {
+	return lhs.index() < rhs.index();
+}
+
+template <typename T>
+bool operator<=(chunk_iterator<T> const& lhs, chunk_iterator<T> const& rhs) noexcept {
+	return lhs.index() <= rhs.index();
+}
+
+template <typename T>
+bool operator>(chunk_iterator<T> const& lhs, chunk_iterator<T> const& rhs) noexcept {
+	return lhs.index() > rhs.index();
+}
+
+template <typename T>
+bool operator>=(chunk_iterator<T> const& lhs, chunk_iterator<T> const& rhs) noexcept {
+	return lhs.index() >= rhs.index();
+}
+
+/** A random access range of consecutive, non-overlapping ropen_interval<T> chunks. Every chunk
+ *  contains chunk_size() elements apart from the last, which may be smaller and is calculated once
+ *  when the range is created.
+ *
+ *  Iterators into a chunk_range refer to the range, so they must not outlive it. */
+template <typename T>
+class chunk_range {
+public:
+	typedef ropen_interval<T> value_type;
+	typedef chunk_iterator<T> iterator;
+	typedef iterator const_iterator;
+	typedef typename iterator::difference_type difference_type;
+
+	/** Constructs the chunks of the \a size elements starting at \a first. Throws
+	 *  invalid_chunk_size if \a chunk_size is not positive, and empty_interval if the element after
+	 *  the last one cannot be represented by T. */
+	chunk_range(T const& first, difference_type size, difference_type chunk_size)
+	: m_first{first}
+	, m_chunk_size{chunk_size}
+	, m_size{0}
+	, m_last{first, first, detail::unchecked_tag{}} {
+		if(chunk_size <= 0) {
+			EZ_THROW(invalid_chunk_size{});
+		}
+
+		if(size != 0) {
+			m_size = (size - 1) / chunk_size + 1;
+			m_last = value_type{detail::advanced(first, (m_size - 1) * chunk_size),
+			                    detail::advanced(first, size)};
+		}
+	}
+
+	/** Returns the number of chunks. */
+	difference_type size() const noexcept {
+		return m_size;
+	}
+
+	bool empty() const noexcept {
+		return m_size == 0;
+	}
+
+	/** Returns the number of elements in each chunk, apart from possibly the last. */
+	difference_type chunk_size() const noexcept {
+		return m_chunk_size;
+	}
+
+	/** Returns the chunk at index \a i, which must be less than size(). */
+	value_type operator[](difference_type i) const {
+		if(i == m_size - 1) {
+			return m_last;
+		}
+
+		auto const lower = detail::advanced(m_first, i * m_chunk_size);
+		return {lower, detail::advanced(lower, m_chunk_size), detail::unchecked_tag{}};
+	}
+
+	value_type front() const {
+		return (*this)[0];
+	}
+
+	value_type const& back() const noexcept {
+		return m_last;
+	}
+
+	iterator begin() const {
+		return {*this, 0};
+	}
+
+	iterator end() const {
+		return {*this, m_size};
+	}
+
+	iterator cbegin() const {
+		return begin();
+	}
+
+	iterator cend() const {
+		return end();
+	}
+
+private:
+	T m_first;
+	difference_type m_chunk_size;
+	difference_type m_size;
+	value_type m_last;
+};
+
+/** Returns a range of ropen_interval<T> chunks which cover the interval \a r in order, where each
+ *  chunk contains \a n elements apart from the last, which contains the remaining elements.
+ *  Throws invalid_chunk_size if \a n is not positive.
+ *
+ *  This is useful to process a large interval in tiles that fit into cache.
+ *
+ *  \code
+ *  for(auto tile : ez::chunks(ez::make_interval[0][9], 4)) {
+ *      std::cout << tile << ' '; // prints [0, 4) [4, 8) [8, 10)
+ *  }
+ *  \endcode */
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+chunk_range<typename Interval::type> chunks(Interval const& r,
+                                            typename Interval::difference_type n) {
+	static_assert(detail::is_countable<typename Interval::type>::value,
+	              "chunks requires an underlying type that supports random access");
+	return {*r.begin(), r.size(), n};
+}
+
+}
+
+#endif
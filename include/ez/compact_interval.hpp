@@ -0,0 +1,196 @@
+/******************************************************************//**
+ * \file   compact_interval.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_1DBCF7CD_6A9A_4368_A731_6E24679D378E
+#define INCLUDE_GUARD_1DBCF7CD_6A9A_4368_A731_6E24679D378E
+
+#include "ez/interval.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace ez {
+
+namespace detail {
+
+// compact_bounds<T> decides how compact_interval<T> stores a bound together with its openness in
+// the space of a single T. Types without spare bits are not supported.
+template <typename T, typename Enable = void>
+struct compact_bounds;
+
+// A pointer to a type with an alignment of at least 2 never has its lowest bit set, so that bit
+// holds the openness and the bound is kept exactly
+template <typename T>
+struct compact_bounds<T*, typename std::enable_if<(alignof(T) >= 2)>::type> {
+	typedef std::uintptr_t storage;
+
+	static storage lower(T* value, bool open) noexcept {
+		return reinterpret_cast<storage>(value) | static_cast<storage>(open);
+	}
+
+	static storage upper(T* value, bool open) noexcept {
+		return lower(value, open);
+	}
+
+	static T* value(storage s) noexcept {
+		return reinterpret_cast<T*>(s & ~static_cast<storage>(1));
+	}
+
+	static bool open(storage s) noexcept {
+		return (s & 1) != 0;
+	}
+};
+
+// Every bit pattern of a floating-point number other than NaN is a distinct value, so there is no
+// room for the openness. Instead an open bound is replaced by the next representable value
+// towards the other bound, which holds exactly the same numbers, and every bound is closed.
+template <typename T>
+struct compact_bounds<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+	typedef T storage;
+
+	static storage lower(T value, bool open) noexcept {
+		return open ? std::nextafter(value, std::numeric_limits<T>::infinity()) : value;
+	}
+
+	static storage upper(T value, bool open) noexcept {
+		return open ? std::nextafter(value, -std::numeric_limits<T>::infinity()) : value;
+	}
+
+	static T value(storage s) noexcept {
+		return s;
+	}
+
+	static bool open(storage) noexcept {
+		return false;
+	}
+};
+
+}
+
+/** An interval that stores its openness inside its bounds, so that it is the size of two T rather
+ *  than two T and an ez::openness. This matters for large arrays of intervals, where
+ *  sizeof(interval<double>) is 24 bytes and sizeof(compact_interval<double>) is 16.
+ *
+ *  compact_interval satisfies is_interval and has the same lower(), upper(), left_open() and
+ *  right_open() accessors as interval, so contains, intersection, hull and the other functions on
+ *  intervals work on it. It is available for:
+ *
+ *  * pointers to types with an alignment of at least 2, where the openness is kept in the lowest
+ *    bit of each bound and the interval is stored exactly.
+ *  * floating-point types, where there are no unused bits. An open bound is stored as the next
+ *    representable value towards the other bound, so a compact_interval holds exactly the same
+ *    numbers as the interval it was constructed from but is always closed. An interval such as
+ *    (1.0, std::nextafter(1.0, 2.0)) holds no numbers and throws empty_interval.
+ *
+ *  \code
+ *  ez::compact_interval<double> r = ez::make_interval(0.0)[1.0];
+ *  assert(contains(r, 1.0) && !contains(r, 0.0));
+ *  ez::interval<double> i = r; // [4.9e-324, 1]
+ *  \endcode */
+template <typename T>
+class compact_interval {
+	typedef detail::compact_bounds<T> bounds;
+	typedef typename bounds::storage storage;
+
+public:
+	typedef T type;
+	typedef typename interval<T>::difference_type difference_type;
+
+	/** Constructs an interval from \a lower to \a upper, or throws empty_interval if it would hold
+	 *  no values. */
+	compact_interval(T const& lower, T const& upper, bool left_open, bool right_open)
+	: m_lower{bounds::lower(lower, left_open)}
+	, m_upper{bounds::upper(upper, right_open)} {
+		if(!detail::valid(lower, upper, left_open, right_open) ||
+		   !detail::valid(this->lower(), this->upper(), this->left_open(), this->right_open())) {
+			EZ_THROW(empty_interval{});
+		}
+	}
+
+	compact_interval(T const& lower, T const& upper, openness o)
+	: compact_interval{lower, upper, (o & ez::left_open) != 0, (o & ez::right_open) != 0} {
+	}
+
+	template <bool LOpen, bool ROpen>
+	compact_interval(basic_interval<T, LOpen, ROpen> const& r)
+	: compact_interval{r.lower(), r.upper(), LOpen, ROpen} {
+	}
+
+	compact_interval(interval<T> const& r)
+	: compact_interval{r.lower(), r.upper(), r.left_open(), r.right_open()} {
+	}
+
+	T lower() const noexcept {
+		return bounds::value(m_lower);
+	}
+
+	T upper() const noexcept {
+		return bounds::value(m_upper);
+	}
+
+	bool left_open() const noexcept {
+		return bounds::open(m_lower);
+	}
+
+	bool left_closed() const noexcept {
+		return !left_open();
+	}
+
+	bool right_open() const noexcept {
+		return bounds::open(m_upper);
+	}
+
+	bool right_closed() const noexcept {
+		return !right_open();
+	}
+
+	operator interval<T>() const noexcept {
+		return {lower(), upper(), left_open(), right_open(), detail::unchecked_tag{}};
+	}
+
+private:
+	storage m_lower;
+	storage m_upper;
+};
+
+template <typename T>
+struct is_interval<compact_interval<T>> : std::true_type {
+};
+
+template <typename T>
+std::ostream& operator<<(std::ostream& stream, compact_interval<T> const& r) {
+	return stream << interval<T>{r};
+}
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+/******************************************************************//**
+ * \file   concurrent_interval_tree.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_4F6A4AD6_3110_41D9_9933_D356A08CE0B0
+#define INCLUDE_GUARD_4F6A4AD6_3110_41D9_9933_D356A08CE0B0
+
+#include "ez/interval.hpp"
+#include "ez/interval_tree.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ez {
+
+/** An interval_tree that many threads can insert into, erase from and query at the same time.
+ *
+ *  The intervals are spread over a number of shards, each an interval_tree with its own mutex.
+ *  Inserts go to the shards in turn and an erase only locks the shard holding its interval, so
+ *  writers to different shards run in parallel with each other and with queries. A query locks
+ *  one shard at a time, so it sees each shard at a single point in time but may see the effects
+ *  of writes to other shards made while it runs.
+ *
+ *  Queries call the visitor with the lock of a shard held, so the visitor must not use the tree.
+ *  Within a shard the intervals are visited in order of lower bound, but there is no order across
+ *  shards.
+ *
+ *  \code
+ *  ez::concurrent_interval_tree<int, std::string> tree;
+ *  std::thread writer{[&]{ tree.insert(ez::make_interval[0](10), "a"); }};
+ *  tree.insert(ez::make_interval(5)[20], "b");
+ *  writer.join();
+ *  tree.containing(7, [](ez::interval<int> const&, std::string const& s) {
+ *      std::cout << s; // prints a and b in either order
+ *  });
+ *  \endcode */
+template <typename T, typename Value>
+class concurrent_interval_tree {
+public:
+	typedef T type;
+	typedef Value value_type;
+	typedef std::size_t size_type;
+
+	/** Identifies an interval in the tree, which stays valid until that interval is erased. */
+	typedef std::size_t handle;
+
+	/** Creates a tree with \a shards shards, which limits how many threads can write at once. */
+	explicit concurrent_interval_tree(std::size_t shards = default_shards())
+	: m_shards(shards > 0 ? shards : 1)
+	, m_next{0} {
+		for(auto& s : m_shards) {
+			s.reset(new shard{});
+		}
+	}
+
+	concurrent_interval_tree(concurrent_interval_tree const&) = delete;
+	concurrent_interval_tree& operator=(concurrent_interval_tree const&) = delete;
+
+	/** Returns the number of intervals, which may already be out of date if other threads are
+	 *  writing. */
+	size_type size() const {
+		size_type n = 0;
+		for(auto const& s : m_shards) {
+			std::lock_guard<std::mutex> lock{s->mutex};
+			n += s->tree.size();
+		}
+		return n;
+	}
+
+	/** Adds \a r with the value \a value and returns a handle to it. */
+	handle insert(interval<T> const& r, Value value) {
+		auto const i = m_next.fetch_add(1, std::memory_order_relaxed) % m_shards.size();
+		auto& s = *m_shards[i];
+		std::lock_guard<std::mutex> lock{s.mutex};
+		return s.tree.insert(r, std::move(value)) * m_shards.size() + i;
+	}
+
+	/** Removes the interval \a h, which must have been returned by insert and not yet erased. */
+	void erase(handle h) {
+		auto& s = *m_shards[h % m_shards.size()];
+		std::lock_guard<std::mutex> lock{s.mutex};
+		s.tree.erase(h / m_shards.size());
+	}
+
+	/** Returns a copy of the value of \a h. */
+	Value value(handle h) const {
+		auto const& s = *m_shards[h % m_shards.size()];
+		std::lock_guard<std::mutex> lock{s.mutex};
+		return s.tree.value(h / m_shards.size());
+	}
+
+	/** Calls \a f(r, value) for every interval r that contains \a x. */
+	template <typename Visitor>
+	void containing(T const& x, Visitor f) const {
+		for(auto const& s : m_shards) {
+			std::lock_guard<std::mutex> lock{s->mutex};
+			s->tree.containing(x, std::ref(f));
+		}
+	}
+
+	/** Calls \a f(r, value) for every interval r that has at least one value in common with
+	 *  \a query. */
+	template <typename Visitor>
+	void overlapping(interval<T> const& query, Visitor f) const {
+		for(auto const& s : m_shards) {
+			std::lock_guard<std::mutex> lock{s->mutex};
+			s->tree.overlapping(query, std::ref(f));
+		}
+	}
+
+private:
+	struct shard {
+		mutable std::mutex mutex;
+		interval_tree<T, Value> tree;
+	};
+
+	static std::size_t default_shards() noexcept {
+		auto const hardware = std::thread::hardware_concurrency();
+		return hardware > 0 ? hardware : 1;
+	}
+
+	std::vector<std::unique_ptr<shard>> m_shards;
+	std::atomic<std::size_t> m_next;
+};
+
+}
+
+#endif
@@ -0,0 +1,209 @@
+/******************************************************************//**
+ * \file   contains_bulk.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_A6ACC77C_4585_47D0_A20D_FA1E5EABB390
+#define INCLUDE_GUARD_A6ACC77C_4585_47D0_A20D_FA1E5EABB390
+
+#include "ez/interval.hpp"
+#include "ez/simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ez {
+
+namespace detail {
+
+// The kernels take the openness as template parameters so that the loops never test it
+template <typename T>
+struct scalar_bulk_kernels {
+	template <bool LOpen, bool ROpen>
+	static bool inside(T const& lower, T const& upper, T const& value) {
+		// & rather than && so that there is no branch on the value
+		return (LOpen ? lower < value : lower <= value) & (ROpen ? upper > value : upper >= value);
+	}
+
+	template <bool LOpen, bool ROpen>
+	static std::uint64_t word(T const& lower, T const& upper, T const* values, std::size_t m) {
+		std::uint64_t bits = 0;
+		for(std::size_t j = 0; j < m; ++j) {
+			bits |= static_cast<std::uint64_t>(inside<LOpen, ROpen>(lower, upper, values[j])) << j;
+		}
+		return bits;
+	}
+
+	// Writes the bits of values from first, which is a multiple of 64
+	template <bool LOpen, bool ROpen>
+	static void contains(T const& lower, T const& upper, T const* values, std::size_t n,
+	                     std::uint64_t* out, std::size_t first = 0) {
+		auto const words = n / 64;
+		for(auto i = first; i < 64 * words; i += 64) {
+			out[i / 64] = word<LOpen, ROpen>(lower, upper, values + i, 64);
+		}
+		if(n % 64 != 0) {
+			out[words] = word<LOpen, ROpen>(lower, upper, values + 64 * words, n % 64);
+		}
+	}
+
+	template <bool LOpen, bool ROpen>
+	static std::size_t count(T const& lower, T const& upper, T const* values, std::size_t n,
+	                         std::size_t first = 0) {
+		std::size_t count = 0;
+		for(auto i = first; i < n; ++i) {
+			count += inside<LOpen, ROpen>(lower, upper, values[i]);
+		}
+		return count;
+	}
+};
+
+template <typename T>
+struct bulk_kernels : scalar_bulk_kernels<T> {
+};
+
+#ifdef EZ_SIMD
+
+template <typename Simd>
+struct simd_bulk_kernels {
+	typedef typename Simd::type T;
+	typedef typename Simd::vec vec;
+	typedef scalar_bulk_kernels<T> scalar;
+	static std::size_t const width = Simd::width;
+
+	template <bool LOpen, bool ROpen>
+	static std::uint64_t inside(vec lower, vec upper, T const* values) {
+		auto const v = Simd::load(values);
+		return Simd::to_bits(LOpen ? Simd::lt(lower, v) : Simd::le(lower, v)) &
+		       Simd::to_bits(ROpen ? Simd::lt(v, upper) : Simd::le(v, upper));
+	}
+
+	template <bool LOpen, bool ROpen>
+	static void contains(T const& lower, T const& upper, T const* values, std::size_t n,
+	                     std::uint64_t* out) {
+		auto const l = Simd::set1(lower);
+		auto const u = Simd::set1(upper);
+		auto const words = n / 64;
+		for(std::size_t w = 0; w < words; ++w) {
+			std::uint64_t bits = 0;
+			for(std::size_t j = 0; j < 64; j += width) {
+				bits |= inside<LOpen, ROpen>(l, u, values + 64 * w + j) << j;
+			}
+			out[w] = bits;
+		}
+		scalar::template contains<LOpen, ROpen>(lower, upper, values, n, out, 64 * words);
+	}
+
+	template <bool LOpen, bool ROpen>
+	static std::size_t count(T const& lower, T const& upper, T const* values, std::size_t n) {
+		auto const l = Simd::set1(lower);
+		auto const u = Simd::set1(upper);
+		auto const blocks = n - n % width;
+		std::size_t count = 0;
+		for(std::size_t i = 0; i < blocks; i += width) {
+			count += popcount(inside<LOpen, ROpen>(l, u, values + i));
+		}
+		return count + scalar::template count<LOpen, ROpen>(lower, upper, values, n, blocks);
+	}
+};
+
+template <>
+struct bulk_kernels<double> : simd_bulk_kernels<simd<double>> {
+};
+
+template <>
+struct bulk_kernels<float> : simd_bulk_kernels<simd<float>> {
+};
+
+template <>
+struct bulk_kernels<std::int32_t> : simd_bulk_kernels<simd<std::int32_t>> {
+};
+
+template <>
+struct bulk_kernels<std::int64_t> : simd_bulk_kernels<simd<std::int64_t>> {
+};
+
+#endif
+
+}
+
+/** Sets bit i % 64 of \a out[i / 64] to whether \a r contains \a values[i], for each of the \a n
+ *  values, and clears the bits after the last value. \a out must have room for (n + 63) / 64
+ *  words.
+ *
+ *  The openness of \a r is checked once rather than for each value, and values of type double,
+ *  float, std::int32_t and std::int64_t are compared with AVX2 or AVX-512 when the compiler
+ *  targets them. Define EZ_NO_SIMD to always use the scalar code.
+ *
+ *  \code
+ *  int const values[] = {-1, 0, 3, 5, 9};
+ *  std::uint64_t bits;
+ *  ez::contains_bulk(ez::make_interval(0)[5], values, 5, &bits); // bits = 0b01100
+ *  \endcode */
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+void contains_bulk(Interval const& r, typename Interval::type const* values, std::size_t n,
+                   std::uint64_t* out) {
+	typedef detail::bulk_kernels<typename Interval::type> kernels;
+	if(r.left_open()) {
+		if(r.right_open()) {
+			kernels::template contains<true, true>(r.lower(), r.upper(), values, n, out);
+		} else {
+			kernels::template contains<true, false>(r.lower(), r.upper(), values, n, out);
+		}
+	} else {
+		if(r.right_open()) {
+			kernels::template contains<false, true>(r.lower(), r.upper(), values, n, out);
+		} else {
+			kernels::template contains<false, false>(r.lower(), r.upper(), values, n, out);
+		}
+	}
+}
+
+/** Returns how many of the \a n values starting at \a values are contained in \a r, in the same
+ *  way as contains_bulk. */
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+std::size_t count_contained(Interval const& r, typename Interval::type const* values,
+                            std::size_t n) {
+	typedef detail::bulk_kernels<typename Interval::type> kernels;
+	if(r.left_open()) {
+		return r.right_open()
+		  ? kernels::template count<true, true>(r.lower(), r.upper(), values, n)
+		  : kernels::template count<true, false>(r.lower(), r.upper(), values, n);
+	} else {
+		return r.right_open()
+		  ? kernels::template count<false, true>(r.lower(), r.upper(), values, n)
+		  : kernels::template count<false, false>(r.lower(), r.upper(), values, n);
+	}
+}
+
+}
+
+#endif
@@ -35,6 +35,14 @@
 #include <type_traits>
 #include <utility>
 
+// EZ_CONSTEXPR14 marks functions that can only be constexpr under the relaxed rules of C++14, such
+// as those with loops, local variables or more than one statement
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304
+#define EZ_CONSTEXPR14 constexpr
+#else
+#define EZ_CONSTEXPR14
+#endif
+
 namespace ez {
 
 namespace detail {
@@ -203,6 +211,26 @@ struct iterator_tag
 		std::remove_reference<decltype(input_compatible<T>(0))>::type::value> {
 };
 
+
+
+// is_wrapping<T> is true for the integral types, whose arithmetic in counted_iterator<T> is done
+// modulo 2^N so that the end iterator of a range ending at std::numeric_limits<T>::max() is valid
+template <typename T>
+struct is_wrapping
+	: std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value> {
+};
+
+// wrapping_advance adds n to value without overflowing for the integral types
+template <typename T, typename Difference>
+EZ_CONSTEXPR14 void wrapping_advance(T& value, Difference n, std::true_type) {
+	typedef typename std::make_unsigned<T>::type unsigned_type;
+	value = static_cast<T>(static_cast<unsigned_type>(value) + static_cast<unsigned_type>(n));
+}
+
+template <typename T, typename Difference>
+EZ_CONSTEXPR14 void wrapping_advance(T& value, Difference n, std::false_type) {
+	value += n;
+}
 }
 
 template <typename T>
@@ -211,7 +239,7 @@ class direct_iterator;
 /** This is a convenience function template that constructs an ez::direct_iterator for
  *  \a value the type deduced from the type of the argument. */
 template <typename T>
-direct_iterator<T> make_direct_iterator(T const& value);
+constexpr direct_iterator<T> make_direct_iterator(T const& value);
 
 /** An iterator for a type T, that when dereferenced, will return a reference to T, rather than
  *  what T dereferences to.
@@ -249,65 +277,66 @@ public:
 	typedef T const& reference;
 	typedef typename detail::iterator_tag<T>::tag iterator_category;
 
-	direct_iterator() noexcept(std::is_nothrow_default_constructible<T>::value)
+	constexpr direct_iterator() noexcept(std::is_nothrow_default_constructible<T>::value)
 	: m_value{} {
 	}
 
-	explicit direct_iterator(T const& value) noexcept(std::is_nothrow_copy_constructible<T>::value)
+	constexpr explicit direct_iterator(T const& value) noexcept(std::is_nothrow_copy_constructible<T>::value)
 	: m_value{value} {
 	}
 
-	explicit direct_iterator(T&& value) noexcept(std::is_nothrow_move_constructible<T>::value)
+	EZ_CONSTEXPR14 explicit direct_iterator(T&& value)
+	  noexcept(std::is_nothrow_move_constructible<T>::value)
 	: m_value{std::move(value)} {
 	}
 
-	reference operator*() const noexcept {
+	constexpr reference operator*() const noexcept {
 		return m_value;
 	}
 
-	pointer operator->() const noexcept {
+	constexpr pointer operator->() const noexcept {
 		return &m_value;
 	}
 
-	direct_iterator<T>& operator++() {
+	EZ_CONSTEXPR14 direct_iterator<T>& operator++() {
 		++m_value;
 		return *this;
 	}
 
-	direct_iterator<T> operator++(int) {
+	EZ_CONSTEXPR14 direct_iterator<T> operator++(int) {
 		auto const copy = *this;
 		++(*this);
 		return copy;
 	}
 
-	direct_iterator<T>& operator--() {
+	EZ_CONSTEXPR14 direct_iterator<T>& operator--() {
 		--m_value;
 		return *this;
 	}
 
-	direct_iterator<T> operator--(int) {
+	EZ_CONSTEXPR14 direct_iterator<T> operator--(int) {
 		auto const copy = *this;
 		--(*this);
 		return copy;
 	}
 
-	direct_iterator<T>& operator+=(difference_type n) {
+	EZ_CONSTEXPR14 direct_iterator<T>& operator+=(difference_type n) {
 		m_value += n;
 		return *this;
 	}
 
-	direct_iterator<T>& operator-=(difference_type n) {
+	EZ_CONSTEXPR14 direct_iterator<T>& operator-=(difference_type n) {
 		m_value -= n;
 		return *this;
 	}
 
-	direct_iterator<T> operator-(difference_type n) const {
+	EZ_CONSTEXPR14 direct_iterator<T> operator-(difference_type n) const {
 		auto copy = *this;
 		copy -= n;
 		return copy;
 	}
 
-	direct_iterator<T> operator[](difference_type n) const {
+	constexpr direct_iterator<T> operator[](difference_type n) const {
 		return direct_iterator<T>{static_cast<T>(m_value + n)};
 	}
 
@@ -316,6 +345,7 @@ private:
 };
 
 template <typename T>
+EZ_CONSTEXPR14
 direct_iterator<T> operator+(direct_iterator<T> it,
                              typename direct_iterator<T>::difference_type n) {
 	it += n;
@@ -323,6 +353,7 @@ direct_iterator<T> operator+(direct_iterator<T> it,
 }
 
 template <typename T>
+EZ_CONSTEXPR14
 direct_iterator<T> operator+(typename direct_iterator<T>::difference_type n,
                              direct_iterator<T> it) {
 	it += n;
@@ -330,6 +361,7 @@ direct_iterator<T> operator+(typename direct_iterator<T>::difference_type n,
 }
 
 template <typename T>
+EZ_CONSTEXPR14
 direct_iterator<T> operator-(direct_iterator<T> it,
                              typename direct_iterator<T>::difference_type n) {
 	it -= n;
@@ -337,46 +369,199 @@ direct_iterator<T> operator-(direct_iterator<T> it,
 }
 
 template <typename T>
-typename direct_iterator<T>::difference_type operator-(direct_iterator<T> const& lhs,
-                                                       direct_iterator<T> const& rhs) {
+constexpr typename direct_iterator<T>::difference_type operator-(
+  direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
 	return *lhs - *rhs;
 }
 
 template <typename T>
-bool operator==(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
+constexpr bool operator==(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
 	return *lhs == *rhs;
 }
 
 template <typename T>
-bool operator!=(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
+constexpr bool operator!=(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
 	return *lhs != *rhs;
 }
 
 template <typename T>
-bool operator<(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
+constexpr bool operator<(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
 	return *lhs < *rhs;
 }
 
 template <typename T>
-bool operator<=(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
+constexpr bool operator<=(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
 	return *lhs <= *rhs;
 }
 
 template <typename T>
-bool operator>(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
+constexpr bool operator>(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
 	return *lhs > *rhs;
 }
 
 template <typename T>
-bool operator>=(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
+constexpr bool operator>=(direct_iterator<T> const& lhs, direct_iterator<T> const& rhs) {
 	return *lhs >= *rhs;
 }
 
 template <typename T>
-direct_iterator<T> make_direct_iterator(T const& value) {
+constexpr direct_iterator<T> make_direct_iterator(T const& value) {
 	return direct_iterator<T>{value};
 }
 
+/** A random access iterator over a type T that, like direct_iterator<T>, returns a reference to T
+ *  when dereferenced, but also keeps track of how many times it has been advanced.
+ *
+ *  Two counted_iterators are compared using only their counts, so a loop between two
+ *  counted_iterators is a simple counted loop that compilers can unroll and vectorize, and the end
+ *  iterator of a range is never compared by value. Arithmetic on integral types wraps around
+ *  instead of overflowing, which allows ranges whose last element is std::numeric_limits<T>::max().
+ *
+ *  Comparing counted_iterators that were not created from the same range is undefined.
+ *
+ *  \code
+ *  auto const first = ez::counted_iterator<int>{INT_MAX - 2, 0};
+ *  std::copy(first, first + 3,
+ *            std::ostream_iterator<int>(std::cout, " ")); // prints the 3 largest ints
+ *  \endcode */
+template <typename T>
+class counted_iterator {
+public:
+	typedef T value_type;
+	typedef typename detail::difference_type<T>::type difference_type;
+	typedef T const* pointer;
+	typedef T const& reference;
+	typedef std::random_access_iterator_tag iterator_category;
+
+	constexpr counted_iterator() noexcept(std::is_nothrow_default_constructible<T>::value)
+	: m_value{}
+	, m_count{} {
+	}
+
+	constexpr counted_iterator(T const& value, difference_type count)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: m_value{value}
+	, m_count{count} {
+	}
+
+	constexpr reference operator*() const noexcept {
+		return m_value;
+	}
+
+	constexpr pointer operator->() const noexcept {
+		return &m_value;
+	}
+
+	/** Returns the number of times this iterator has been advanced from the start of its range. */
+	constexpr difference_type count() const noexcept {
+		return m_count;
+	}
+
+	EZ_CONSTEXPR14 counted_iterator<T>& operator++() {
+		detail::wrapping_advance(m_value, difference_type{1}, detail::is_wrapping<T>{});
+		++m_count;
+		return *this;
+	}
+
+	EZ_CONSTEXPR14 counted_iterator<T> operator++(int) {
+		auto const copy = *this;
+		++(*this);
+		return copy;
+	}
+
+	EZ_CONSTEXPR14 counted_iterator<T>& operator--() {
+		detail::wrapping_advance(m_value, difference_type{-1}, detail::is_wrapping<T>{});
+		--m_count;
+		return *this;
+	}
+
+	EZ_CONSTEXPR14 counted_iterator<T> operator--(int) {
+		auto const copy = *this;
+		--(*this);
+		return copy;
+	}
+
+	EZ_CONSTEXPR14 counted_iterator<T>& operator+=(difference_type n) {
+		detail::wrapping_advance(m_value, n, detail::is_wrapping<T>{});
+		m_count += n;
+		return *this;
+	}
+
+	EZ_CONSTEXPR14 counted_iterator<T>& operator-=(difference_type n) {
+		detail::wrapping_advance(m_value, -n, detail::is_wrapping<T>{});
+		m_count -= n;
+		return *this;
+	}
+
+	EZ_CONSTEXPR14 counted_iterator<T> operator-(difference_type n) const {
+		auto copy = *this;
+		copy -= n;
+		return copy;
+	}
+
+	EZ_CONSTEXPR14 T operator[](difference_type n) const {
+		auto copy = m_value;
+		detail::wrapping_advance(copy, n, detail::is_wrapping<T>{});
+		return copy;
+	}
+
+private:
+	T m_value;
+	difference_type m_count;
+};
+
+template <typename T>
+EZ_CONSTEXPR14
+counted_iterator<T> operator+(counted_iterator<T> it,
+                              typename counted_iterator<T>::difference_type n) {
+	it += n;
+	return it;
+}
+
+template <typename T>
+EZ_CONSTEXPR14
+counted_iterator<T> operator+(typename counted_iterator<T>::difference_type n,
+                              counted_iterator<T> it) {
+	it += n;
+	return it;
+}
+
+template <typename T>
+constexpr typename counted_iterator<T>::difference_type operator-(
+  counted_iterator<T> const& lhs, counted_iterator<T> const& rhs) noexcept {
+	return lhs.count() - rhs.count();
+}
+
+template <typename T>
+constexpr bool operator==(counted_iterator<T> const& lhs, counted_iterator<T> const& rhs) noexcept {
+	return lhs.count() == rhs.count();
+}
+
+template <typename T>
+constexpr bool operator!=(counted_iterator<T> const& lhs, counted_iterator<T> const& rhs) noexcept {
+	return lhs.count() != rhs.count();
+}
+
+template <typename T>
+constexpr bool operator<(counted_iterator<T> const& lhs, counted_iterator<T> const& rhs) noexcept {
+	return lhs.count() < rhs.count();
+}
+
+template <typename T>
+constexpr bool operator<=(counted_iterator<T> const& lhs, counted_iterator<T> const& rhs) noexcept {
+	return lhs.count() <= rhs.count();
+}
+
+template <typename T>
+constexpr bool operator>(counted_iterator<T> const& lhs, counted_iterator<T> const& rhs) noexcept {
+	return lhs.count() > rhs.count();
+}
+
+template <typename T>
+constexpr bool operator>=(counted_iterator<T> const& lhs, counted_iterator<T> const& rhs) noexcept {
+	return lhs.count() >= rhs.count();
+}
+
 }
 
 #endif
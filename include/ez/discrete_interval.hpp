@@ -0,0 +1,255 @@
+/******************************************************************//**
+ * \file   discrete_interval.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_270C9C3A_FEDD_49AB_B13D_A2A02D0BB659
+#define INCLUDE_GUARD_270C9C3A_FEDD_49AB_B13D_A2A02D0BB659
+
+#include "ez/interval.hpp"
+
+#include <ostream>
+#include <type_traits>
+
+namespace ez {
+
+/** An interval of an integral type T, stored as its closed bounds.
+ *
+ *  For integral types an open bound is the same as a closed bound moved by one, so (2, 6) holds
+ *  the same values as [3, 5]. discrete_interval stores only the two closed bounds, making it the
+ *  size of two T (8 bytes for int instead of 12 for interval<int>), and its comparisons do not
+ *  depend on any openness.
+ *
+ *  It is constructed from, and converts to, basic_interval and interval without changing the set
+ *  of values held. An interval that holds no integers, such as (2, 3), throws empty_interval.
+ *
+ *  \code
+ *  ez::discrete_interval<int> r = ez::make_interval(2)(6);
+ *  assert(r.lower() == 3 && r.upper() == 5);
+ *  ez::closed_interval<int> c = r; // [3, 5]
+ *  \endcode */
+template <typename T>
+class discrete_interval {
+	static_assert(std::is_integral<T>::value, "discrete_interval requires an integral type");
+
+public:
+	typedef T type;
+	typedef typename closed_interval<T>::difference_type difference_type;
+	typedef typename closed_interval<T>::iterator iterator;
+	typedef iterator const_iterator;
+
+	/** Constructs the interval [lower, upper], or throws empty_interval if upper < lower. */
+	constexpr discrete_interval(T const& lower, T const& upper)
+	: m_lower{detail::check<empty_interval>(!(upper < lower), lower)}
+	, m_upper{upper} {
+	}
+
+	/** Constructs the interval [lower, upper] without checking that it is non-empty, except with
+	 *  assert(). */
+	constexpr discrete_interval(T const& lower, T const& upper, unchecked_t) noexcept
+	: m_lower{detail::assume_valid(lower, upper, false, false)}
+	, m_upper{upper} {
+	}
+
+	/** Constructs the interval holding the same integers as \a r, or throws empty_interval if there
+	 *  are none. An open bound cannot overflow when it is moved, as the other bound is beyond
+	 *  it. */
+	template <bool LOpen, bool ROpen>
+	constexpr discrete_interval(basic_interval<T, LOpen, ROpen> const& r)
+	: discrete_interval{static_cast<T>(r.lower() + LOpen), static_cast<T>(r.upper() - ROpen)} {
+	}
+
+	constexpr discrete_interval(interval<T> const& r)
+	: discrete_interval{static_cast<T>(r.lower() + r.left_open()),
+	                    static_cast<T>(r.upper() - r.right_open())} {
+	}
+
+	constexpr T const& lower() const noexcept {
+		return m_lower;
+	}
+
+	constexpr T const& upper() const noexcept {
+		return m_upper;
+	}
+
+	constexpr bool left_open() const noexcept {
+		return false;
+	}
+
+	constexpr bool left_closed() const noexcept {
+		return true;
+	}
+
+	constexpr bool right_open() const noexcept {
+		return false;
+	}
+
+	constexpr bool right_closed() const noexcept {
+		return true;
+	}
+
+	EZ_CONSTEXPR14 void assign(T const& lower, T const& upper) {
+		if(upper < lower) {
+			EZ_THROW(empty_interval{});
+		}
+
+		m_lower = lower;
+		m_upper = upper;
+	}
+
+	constexpr operator closed_interval<T>() const noexcept {
+		return {m_lower, m_upper, detail::unchecked_tag{}};
+	}
+
+	constexpr operator interval<T>() const noexcept {
+		return {m_lower, m_upper, false, false, detail::unchecked_tag{}};
+	}
+
+	/** Returns the number of elements in this interval in O(1). */
+	constexpr difference_type size() const noexcept {
+		return detail::size<difference_type>(m_lower, m_upper, false, false);
+	}
+
+	EZ_CONSTEXPR14 iterator begin() const {
+		return iteration::begin(m_lower, m_upper, false, false);
+	}
+
+	EZ_CONSTEXPR14 iterator end() const {
+		return iteration::end(m_lower, m_upper, false, false);
+	}
+
+	EZ_CONSTEXPR14 iterator cbegin() const {
+		return begin();
+	}
+
+	EZ_CONSTEXPR14 iterator cend() const {
+		return end();
+	}
+
+private:
+	typedef detail::interval_iteration<T> iteration;
+
+	T m_lower;
+	T m_upper;
+};
+
+/* The functions below compare only the closed bounds, using & and | rather than && and || so that
+   they compile without branches. */
+
+template <typename T>
+constexpr bool operator==(discrete_interval<T> const& lhs, discrete_interval<T> const& rhs)
+  noexcept {
+	return (lhs.lower() == rhs.lower()) & (lhs.upper() == rhs.upper());
+}
+
+template <typename T>
+constexpr bool operator!=(discrete_interval<T> const& lhs, discrete_interval<T> const& rhs)
+  noexcept {
+	return !(lhs == rhs);
+}
+
+/** Returns true if \a value is within the interval \a r. */
+template <typename T>
+constexpr bool contains(discrete_interval<T> const& r, T const& value) noexcept {
+	return (r.lower() <= value) & (value <= r.upper());
+}
+
+/** Returns true if \a a is a subset of \a b. */
+template <typename T>
+constexpr bool subset(discrete_interval<T> const& a, discrete_interval<T> const& b) noexcept {
+	return (b.lower() <= a.lower()) & (a.upper() <= b.upper());
+}
+
+/** Returns true if \a a is a superset of \a b. */
+template <typename T>
+constexpr bool superset(discrete_interval<T> const& a, discrete_interval<T> const& b) noexcept {
+	return subset(b, a);
+}
+
+/** Returns true if \a a is a subset of \a b but not equal to it. */
+template <typename T>
+constexpr bool proper_subset(discrete_interval<T> const& a, discrete_interval<T> const& b)
+  noexcept {
+	return subset(a, b) & (a != b);
+}
+
+/** Returns true if \a a is a superset of \a b but not equal to it. */
+template <typename T>
+constexpr bool proper_superset(discrete_interval<T> const& a, discrete_interval<T> const& b)
+  noexcept {
+	return proper_subset(b, a);
+}
+
+/** Returns true if \a lhs and \a rhs have at least one element in common. */
+template <typename T>
+constexpr bool overlaps(discrete_interval<T> const& lhs, discrete_interval<T> const& rhs)
+  noexcept {
+	return (lhs.lower() <= rhs.upper()) & (rhs.lower() <= lhs.upper());
+}
+
+// intersection and hull use the conditional operator rather than std::min and std::max, which
+// are not constexpr until C++14
+
+/** Returns the intersection of \a lhs and \a rhs, or throws empty_interval if they do not
+ *  overlap. */
+template <typename T>
+constexpr discrete_interval<T> intersection(discrete_interval<T> const& lhs,
+                                            discrete_interval<T> const& rhs) {
+	return {lhs.lower() < rhs.lower() ? rhs.lower() : lhs.lower(),
+	        rhs.upper() < lhs.upper() ? rhs.upper() : lhs.upper()};
+}
+
+/** Returns the smallest interval containing both \a lhs and \a rhs. */
+template <typename T>
+constexpr discrete_interval<T> hull(discrete_interval<T> const& lhs,
+                                    discrete_interval<T> const& rhs) noexcept {
+	return {rhs.lower() < lhs.lower() ? rhs.lower() : lhs.lower(),
+	        lhs.upper() < rhs.upper() ? rhs.upper() : lhs.upper(), unchecked};
+}
+
+template <typename T>
+constexpr discrete_interval<T> operator+(discrete_interval<T> const& lhs,
+                                         discrete_interval<T> const& rhs) noexcept {
+	return {static_cast<T>(lhs.lower() + rhs.lower()), static_cast<T>(lhs.upper() + rhs.upper()),
+	        unchecked};
+}
+
+template <typename T>
+constexpr discrete_interval<T> operator-(discrete_interval<T> const& lhs,
+                                         discrete_interval<T> const& rhs) noexcept {
+	return {static_cast<T>(lhs.lower() - rhs.upper()), static_cast<T>(lhs.upper() - rhs.lower()),
+	        unchecked};
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& stream, discrete_interval<T> const& r) {
+	return stream << "[" << r.lower() << ", " << r.upper() << "]";
+}
+
+}
+
+#endif
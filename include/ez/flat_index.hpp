@@ -0,0 +1,147 @@
+/******************************************************************//**
+ * \file   flat_index.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_C0D4E432_84E4_42B5_BA88_39D4E098487E
+#define INCLUDE_GUARD_C0D4E432_84E4_42B5_BA88_39D4E098487E
+
+#include "ez/simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ez {
+
+namespace detail {
+
+// The number of keys in each node of a flat_index
+std::size_t const node_width = 16;
+
+// Returns the number of the node_width keys starting at node that are at most x
+template <typename K>
+std::size_t count_not_greater(K const* node, K const& x) noexcept {
+	// A binary search without branches, where node[count] is the next key to check
+	std::size_t count = 0;
+	for(auto step = node_width / 2; step > 0; step /= 2) {
+		count += (node[count + step - 1] <= x) ? step : 0;
+	}
+	return count + (node[count] <= x);
+}
+
+#ifdef EZ_SIMD
+
+// Nodes of double, float, std::int32_t and std::int64_t keys compare every key at once
+template <typename Simd>
+std::size_t simd_count_not_greater(typename Simd::type const* node,
+                                   typename Simd::type x) noexcept {
+	auto const value = Simd::set1(x);
+	std::size_t count = 0;
+	for(std::size_t i = 0; i < node_width; i += Simd::width) {
+		count += popcount(Simd::to_bits(Simd::le(Simd::load(node + i), value)));
+	}
+	return count;
+}
+
+inline std::size_t count_not_greater(double const* node, double const& x) noexcept {
+	return simd_count_not_greater<simd<double>>(node, x);
+}
+
+inline std::size_t count_not_greater(float const* node, float const& x) noexcept {
+	return simd_count_not_greater<simd<float>>(node, x);
+}
+
+inline std::size_t count_not_greater(std::int32_t const* node, std::int32_t const& x) noexcept {
+	return simd_count_not_greater<simd<std::int32_t>>(node, x);
+}
+
+inline std::size_t count_not_greater(std::int64_t const* node, std::int64_t const& x) noexcept {
+	return simd_count_not_greater<simd<std::int64_t>>(node, x);
+}
+
+#endif
+
+// A search index over sorted keys in the style of a B+ tree, stored flat with one vector for each
+// level. Level 0 is every key and each level above has the first key of every node of the level
+// below. Each level is padded to whole nodes with copies of its last key.
+template <typename K>
+class flat_index {
+public:
+	flat_index() = default;
+
+	template <typename ForwardIterator>
+	flat_index(ForwardIterator first, ForwardIterator last) {
+		std::vector<K> level(first, last);
+		while(!level.empty()) {
+			auto const n = level.size();
+			level.resize((n + node_width - 1) / node_width * node_width, level.back());
+			m_levels.push_back(level_type{n, level});
+			if(n <= node_width) {
+				break;
+			}
+
+			std::vector<K> above;
+			above.reserve(n / node_width + node_width);
+			for(std::size_t i = 0; i < n; i += node_width) {
+				above.push_back(level[i]);
+			}
+			level.swap(above);
+		}
+	}
+
+	// Returns the number of keys that are at most key
+	std::size_t count_not_greater(K const& key) const {
+		if(m_levels.empty() || !(m_levels.back().keys.front() <= key)) {
+			return 0;
+		}
+
+		// Every node searched has its first key at most key, so the count is at least one
+		std::size_t i = 0;
+		for(auto level = m_levels.rbegin(); level != m_levels.rend(); ++level) {
+			auto const node = i * node_width;
+			auto const count = detail::count_not_greater(level->keys.data() + node, key);
+			i = std::min(node + count, level->size) - 1;
+		}
+		return i + 1;
+	}
+
+private:
+	struct level_type {
+		std::size_t size;
+		std::vector<K> keys;
+	};
+
+	std::vector<level_type> m_levels;
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,197 @@
+/******************************************************************//**
+ * \file   grouped_intervals.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_325A3ABA_5BC0_48A4_86F9_A2273579AA01
+#define INCLUDE_GUARD_325A3ABA_5BC0_48A4_86F9_A2273579AA01
+
+#include "ez/contains_bulk.hpp"
+#include "ez/interval.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ez {
+
+/** A copy of an array of interval<T> grouped by openness, so that loops over it run the kernels of
+ *  basic_interval<T, LOpen, ROpen> with the openness known at compile time instead of testing the
+ *  openness of each interval.
+ *
+ *  The intervals are grouped once on construction with a stable counting sort, and their bounds
+ *  are copied into contiguous arrays for each group. Results are written back to the position of
+ *  each interval in the original array, and each group is visited in its original order.
+ *
+ *  \code
+ *  std::vector<ez::interval<int>> v = {{0, 4, ez::open}, {2, 6, ez::closed}, {4, 8, ez::open}};
+ *  ez::grouped_intervals<int> g{v.data(), v.size()};
+ *  auto n = g.count_containing(4); // 1
+ *  bool hits[3];
+ *  g.contains(4, hits); // {false, true, false}
+ *  \endcode */
+template <typename T>
+class grouped_intervals {
+public:
+	typedef T type;
+
+	grouped_intervals()
+	: m_offsets{} {
+	}
+
+	/** Groups the \a n intervals starting at \a intervals by openness. */
+	grouped_intervals(interval<T> const* intervals, std::size_t n)
+	: m_lower(n)
+	, m_upper(n)
+	, m_index(n)
+	, m_offsets{} {
+		for(std::size_t i = 0; i < n; ++i) {
+			++m_offsets[intervals[i].left_open() * ez::left_open +
+			            intervals[i].right_open() * ez::right_open + 1];
+		}
+
+		for(std::size_t o = 1; o < groups; ++o) {
+			m_offsets[o + 1] += m_offsets[o];
+		}
+
+		std::size_t next[groups];
+		std::copy(m_offsets, m_offsets + groups, next);
+		for(std::size_t i = 0; i < n; ++i) {
+			auto const j = next[intervals[i].left_open() * ez::left_open +
+			                    intervals[i].right_open() * ez::right_open]++;
+			m_lower[j] = intervals[i].lower();
+			m_upper[j] = intervals[i].upper();
+			m_index[j] = i;
+		}
+	}
+
+	/** Returns the number of intervals. */
+	std::size_t size() const noexcept {
+		return m_index.size();
+	}
+
+	/** Returns the number of intervals with openness \a o. */
+	std::size_t size(openness o) const noexcept {
+		return m_offsets[o + 1] - m_offsets[o];
+	}
+
+	/** Returns the number of intervals that contain \a value. */
+	std::size_t count_containing(T const& value) const {
+		return count<false, false>(value) + count<true, false>(value) +
+		       count<false, true>(value) + count<true, true>(value);
+	}
+
+	/** Sets \a out[i] to whether the i-th interval of the original array contains \a value. \a out
+	 *  must have room for size() elements. */
+	void contains(T const& value, bool* out) const {
+		contains<false, false>(value, out);
+		contains<true, false>(value, out);
+		contains<false, true>(value, out);
+		contains<true, true>(value, out);
+	}
+
+	/** Calls \a f(i, r) for each interval, where i is its position in the original array and r is
+	 *  a basic_interval<T, LOpen, ROpen> with the same bounds. \a f must accept each of the four
+	 *  basic_interval types. */
+	template <typename Function>
+	void for_each(Function f) const {
+		for_each<false, false>(f);
+		for_each<true, false>(f);
+		for_each<false, true>(f);
+		for_each<true, true>(f);
+	}
+
+	/** Sets \a out[i] to \a f(r) for each interval, where i and r are as for for_each. */
+	template <typename Function, typename Result>
+	void transform(Function f, Result* out) const {
+		transform<false, false>(f, out);
+		transform<true, false>(f, out);
+		transform<false, true>(f, out);
+		transform<true, true>(f, out);
+	}
+
+private:
+	static std::size_t const groups = 4;
+
+	template <bool LOpen, bool ROpen>
+	static bool inside(T const& lower, T const& upper, T const& value) {
+		return detail::scalar_bulk_kernels<T>::template inside<LOpen, ROpen>(lower, upper, value);
+	}
+
+	template <bool LOpen, bool ROpen>
+	std::size_t first() const noexcept {
+		return m_offsets[LOpen * ez::left_open + ROpen * ez::right_open];
+	}
+
+	template <bool LOpen, bool ROpen>
+	std::size_t last() const noexcept {
+		return m_offsets[LOpen * ez::left_open + ROpen * ez::right_open + 1];
+	}
+
+	template <bool LOpen, bool ROpen>
+	std::size_t count(T const& value) const {
+		std::size_t count = 0;
+		for(auto j = first<LOpen, ROpen>(); j != last<LOpen, ROpen>(); ++j) {
+			count += inside<LOpen, ROpen>(m_lower[j], m_upper[j], value);
+		}
+		return count;
+	}
+
+	template <bool LOpen, bool ROpen>
+	void contains(T const& value, bool* out) const {
+		for(auto j = first<LOpen, ROpen>(); j != last<LOpen, ROpen>(); ++j) {
+			out[m_index[j]] = inside<LOpen, ROpen>(m_lower[j], m_upper[j], value);
+		}
+	}
+
+	template <bool LOpen, bool ROpen, typename Function>
+	void for_each(Function& f) const {
+		for(auto j = first<LOpen, ROpen>(); j != last<LOpen, ROpen>(); ++j) {
+			f(m_index[j], basic_interval<T, LOpen, ROpen>{m_lower[j], m_upper[j],
+			                                              detail::unchecked_tag{}});
+		}
+	}
+
+	template <bool LOpen, bool ROpen, typename Function, typename Result>
+	void transform(Function& f, Result* out) const {
+		for(auto j = first<LOpen, ROpen>(); j != last<LOpen, ROpen>(); ++j) {
+			out[m_index[j]] = f(basic_interval<T, LOpen, ROpen>{m_lower[j], m_upper[j],
+			                                                    detail::unchecked_tag{}});
+		}
+	}
+
+	std::vector<T> m_lower;
+	std::vector<T> m_upper;
+	std::vector<std::size_t> m_index;
+
+	// The intervals with openness o are at positions m_offsets[o] to m_offsets[o + 1]
+	std::size_t m_offsets[groups + 1];
+};
+
+}
+
+#endif
@@ -33,7 +33,10 @@
 #include "ez/direct_iterator.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
 #include <functional>
 #include <iterator>
 #include <limits>
@@ -61,37 +64,106 @@ struct first_non_void<void, Rest...> {
 };
 
 template <typename T, typename U>
-bool lt_first_gt_second(std::pair<T, U> const& lhs, std::pair<T, U> const& rhs) {
+constexpr bool lt_first_gt_second(std::pair<T, U> const& lhs, std::pair<T, U> const& rhs) {
 	return (lhs.first == rhs.first) ? lhs.second > rhs.second : lhs.first < rhs.first;
 }
 
+// unchecked_tag is passed to constructors to skip checking that the interval is non-empty, when
+// this is already known. Unlike ez::unchecked it does not assert, as it is also used to construct
+// placeholder values that may be empty.
+struct unchecked_tag {
+};
+
 template <typename T>
-bool valid(T const& lower, T const& upper, bool left_open, bool right_open) {
+constexpr bool valid(T const& lower, T const& upper, bool left_open, bool right_open) {
 	return (left_open || right_open) ? lower < upper : lower <= upper;
 }
 
 template <typename T>
-T next_if_true(T value, bool b) {
+EZ_CONSTEXPR14 T next_if_true(T value, bool b) {
 	return b ? ++value : value;
 }
 
+// is_countable<T> is true if the number of elements between two values of T can be found in O(1),
+// in which case intervals of T are iterated with counted_iterator<T>
+template <typename T>
+struct is_countable
+	: std::integral_constant<bool,
+		std::is_same<typename direct_iterator<T>::iterator_category,
+		             std::random_access_iterator_tag>::value &&
+		!std::is_floating_point<T>::value> {
+};
+
+// distance returns upper - lower as a Difference, calculated so that it does not overflow if the
+// result fits in Difference
+template <typename Difference, typename T>
+constexpr Difference distance(T const& lower, T const& upper, std::true_type) {
+	typedef typename std::make_unsigned<T>::type unsigned_type;
+	return static_cast<Difference>(static_cast<unsigned_type>(upper) -
+	                               static_cast<unsigned_type>(lower));
+}
+
+template <typename Difference, typename T>
+constexpr Difference distance(T const& lower, T const& upper, std::false_type) {
+	return upper - lower;
+}
+
+// size returns the number of elements in the interval with bounds lower and upper
+template <typename Difference, typename T>
+constexpr Difference size(T const& lower, T const& upper, bool left_open, bool right_open) {
+	return detail::distance<Difference>(lower, upper, is_wrapping<T>{}) + 1
+	     - left_open - right_open;
+}
+
+// interval_iteration decides which iterator is returned from begin() and end() for an interval of
+// T. Countable types use a counted_iterator so that range-for loops become counted loops and
+// iterating up to std::numeric_limits<T>::max() does not overflow.
+template <typename T, bool Countable = is_countable<T>::value>
+struct interval_iteration {
+	typedef direct_iterator<T> iterator;
+
+	static EZ_CONSTEXPR14 iterator begin(T const& lower, T const&, bool left_open, bool) {
+		return make_direct_iterator(next_if_true(lower, left_open));
+	}
+
+	static EZ_CONSTEXPR14 iterator end(T const&, T const& upper, bool, bool right_open) {
+		return make_direct_iterator(next_if_true(upper, !right_open));
+	}
+};
+
+template <typename T>
+struct interval_iteration<T, true> {
+	typedef counted_iterator<T> iterator;
+	typedef typename iterator::difference_type difference_type;
+
+	static EZ_CONSTEXPR14 iterator begin(T const& lower, T const&, bool left_open, bool) {
+		return {next_if_true(lower, left_open), 0};
+	}
+
+	static EZ_CONSTEXPR14 iterator end(T const& lower, T const& upper, bool left_open,
+	                                   bool right_open) {
+		return begin(lower, upper, left_open, right_open) +
+		       detail::size<difference_type>(lower, upper, left_open, right_open);
+	}
+};
+
 template <typename L, bool LOpen>
 class lower_bound {
 	template <typename U>
 	using common = typename std::common_type<L, U>::type;
 
 public:
-	lower_bound(L const& lower) noexcept(std::is_nothrow_copy_constructible<L>::value)
+	constexpr lower_bound(L const& lower) noexcept(std::is_nothrow_copy_constructible<L>::value)
 	: m_lower{lower} {
 	}
 
 	template <typename U>
-	basic_interval<common<U>, LOpen, true> operator()(U const& upper) const {
+	constexpr basic_interval<common<U>, LOpen, true> operator()(U const& upper) const {
 		return {m_lower, upper};
 	}
 
 	template <typename U>
-	basic_interval<common<U>, LOpen, false> operator[](U const& upper) const {
+	constexpr basic_interval<common<U>, LOpen, false> operator[](U const& upper) const {
 		return {m_lower, upper};
 	}
 
@@ -102,12 +174,12 @@ private:
 class interval_factory {
 public:
 	template <typename L>
-	lower_bound<L, true> operator()(L const& lower) const {
+	constexpr lower_bound<L, true> operator()(L const& lower) const {
 		return {lower};
 	}
 
 	template <typename L>
-	lower_bound<L, false> operator[](L const& lower) const {
+	constexpr lower_bound<L, false> operator[](L const& lower) const {
 		return {lower};
 	}
 };
@@ -130,6 +202,67 @@ struct divide_by_zero : std::runtime_error {
 	}
 };
 
+/** An invalid_partition exception is thrown when an interval cannot be split into the requested
+ *  number of non-empty parts, when the weights of the parts are not positive, or when the
+ *  intervals given to a partition_index do not follow on from each other. */
+struct invalid_partition : std::runtime_error {
+	invalid_partition()
+	: std::runtime_error{"Invalid partition"} {
+	}
+};
+
+/* EZ_THROW(e) throws the exception e. If EZ_NO_EXCEPTIONS is defined it instead writes e.what() to
+   stderr and calls std::abort(), so that the library can be built with -fno-exceptions. Use the
+   functions in ez/checked.hpp to handle these errors without exceptions. */
+#ifdef EZ_NO_EXCEPTIONS
+#define EZ_THROW(e) ::ez::detail::fail(e)
+#else
+#define EZ_THROW(e) throw e
+#endif
+
+namespace detail {
+
+[[noreturn]] inline void fail(std::exception const& e) noexcept {
+	std::fputs(e.what(), stderr);
+	std::fputc('\n', stderr);
+	std::abort();
+}
+
+// check returns value if ok is true and raises Exception otherwise. It is a single expression so
+// that constexpr constructors can check their arguments in an initializer.
+template <typename Exception, typename T>
+constexpr T const& check(bool ok, T const& value) {
+	return ok ? value : (EZ_THROW(Exception{}), value);
+}
+
+}
+
+/** unchecked_t is passed to the constructors and assign functions of basic_interval and interval
+ *  to skip checking that the interval is non-empty, in loops where this is already known. The
+ *  check is still made with assert(), so it only costs anything in builds without NDEBUG.
+ *
+ *  \code
+ *  ez::closed_interval<double> r{0.0, 1.0, ez::unchecked};
+ *  r.assign(r.lower() - 1.0, r.upper() + 1.0, ez::unchecked);
+ *  \endcode */
+struct unchecked_t {
+};
+
+static constexpr unchecked_t unchecked{};
+
+namespace detail {
+
+// assume_valid asserts that the interval is non-empty and returns lower. It is a single expression
+// so that constexpr constructors can use it in an initializer. The casts to void keep the
+// parameters used when NDEBUG removes the assert.
+template <typename T>
+constexpr T const& assume_valid(T const& lower, T const& upper, bool left_open, bool right_open) {
+	return static_cast<void>(upper), static_cast<void>(left_open), static_cast<void>(right_open),
+	       assert(valid(lower, upper, left_open, right_open)), lower;
+}
+
+}
+
 template <typename T>
 struct is_interval : std::false_type {
 };
@@ -163,12 +296,33 @@ public:
 	typedef T type;
 	typedef typename direct_iterator<T>::difference_type difference_type;
 
-	basic_interval(T const& lower, T const& upper)
+	/** The iterator type is counted_iterator<T> if T supports random access and is not a floating
+	 *  point type, and direct_iterator<T> otherwise. */
+	typedef typename detail::interval_iteration<T>::iterator iterator;
+	typedef iterator const_iterator;
+
+	/** Throws empty_interval if the interval is empty. The check is in the initializer so that
+	 *  the constructor is constexpr, and an empty interval in a constant expression fails to
+	 *  compile. */
+	constexpr basic_interval(T const& lower, T const& upper)
+	: m_lower{detail::check<empty_interval>(detail::valid(lower, upper, LOpen, ROpen), lower)}
+	, m_upper{upper} {
+	}
+
+	/** Constructs the interval without checking that it is non-empty, except with assert(). The
+	 *  behaviour is undefined if it is empty. */
+	constexpr basic_interval(T const& lower, T const& upper, unchecked_t)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: m_lower{detail::assume_valid(lower, upper, LOpen, ROpen)}
+	, m_upper{upper} {
+	}
+
+	// Constructs the interval without any check, for placeholder values such as the interval held
+	// by a default constructed iterator, which may be empty
+	constexpr basic_interval(T const& lower, T const& upper, detail::unchecked_tag)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
 	: m_lower{lower}
 	, m_upper{upper} {
-		if(!detail::valid(m_lower, m_upper, LOpen, ROpen)) {
-			throw empty_interval{};
-		}
 	}
 
 	basic_interval(const basic_interval<T, LOpen, ROpen>&) = default;
@@ -177,56 +331,72 @@ public:
 	basic_interval<T, LOpen, ROpen>& operator=(const basic_interval<T, LOpen, ROpen>&) = default;
 	basic_interval<T, LOpen, ROpen>& operator=(basic_interval<T, LOpen, ROpen>&&) = default;
 
-	T const& lower() const noexcept {
+	constexpr T const& lower() const noexcept {
 		return m_lower;
 	}
 
-	T const& upper() const noexcept {
+	constexpr T const& upper() const noexcept {
 		return m_upper;
 	}
 
-	void assign(T const& lower, T const& upper) {
+	EZ_CONSTEXPR14 void assign(T const& lower, T const& upper) {
 		if(!detail::valid(lower, upper, LOpen, ROpen)) {
-			throw empty_interval{};
+			EZ_THROW(empty_interval{});
 		}
 
 		m_lower = lower;
 		m_upper = upper;
 	}
 
-	bool left_open() const noexcept {
+	/** Sets the bounds without checking that the interval is non-empty, except with assert(). */
+	EZ_CONSTEXPR14 void assign(T const& lower, T const& upper, unchecked_t)
+	  noexcept(std::is_nothrow_copy_assignable<T>::value) {
+		assert(detail::valid(lower, upper, LOpen, ROpen));
+		m_lower = lower;
+		m_upper = upper;
+	}
+
+	constexpr bool left_open() const noexcept {
 		return LOpen;
 	}
 
-	bool left_closed() const noexcept {
+	constexpr bool left_closed() const noexcept {
 		return !LOpen;
 	}
 
-	bool right_open() const noexcept {
+	constexpr bool right_open() const noexcept {
 		return ROpen;
 	}
 
-	bool right_closed() const noexcept {
+	constexpr bool right_closed() const noexcept {
 		return !ROpen;
 	}
 
-	direct_iterator<T> begin() const {
-		return make_direct_iterator(detail::next_if_true(m_lower, left_open()));
+	/** Returns the number of elements in this interval in O(1). This is only available if the
+	 *  iterator_category of direct_iterator<T> is random access. */
+	constexpr difference_type size() const {
+		return detail::size<difference_type>(m_lower, m_upper, left_open(), right_open());
 	}
 
-	direct_iterator<T> end() const {
-		return make_direct_iterator(detail::next_if_true(m_upper, right_closed()));
+	EZ_CONSTEXPR14 iterator begin() const {
+		return iteration::begin(m_lower, m_upper, left_open(), right_open());
 	}
 
-	direct_iterator<T> cbegin() const {
-		return make_direct_iterator(detail::next_if_true(m_lower, left_open()));
+	EZ_CONSTEXPR14 iterator end() const {
+		return iteration::end(m_lower, m_upper, left_open(), right_open());
 	}
 
-	direct_iterator<T> cend() const {
-		return make_direct_iterator(detail::next_if_true(m_upper, right_closed()));
+	EZ_CONSTEXPR14 iterator cbegin() const {
+		return begin();
+	}
+
+	EZ_CONSTEXPR14 iterator cend() const {
+		return end();
 	}
 
 private:
+	typedef detail::interval_iteration<T> iteration;
+
 	template <typename Container>
 	friend basic_interval<typename Container::iterator, false, true> iterate(Container&);
 
@@ -294,7 +464,19 @@ ropen_interval<typename Container::size_type> indices(const Container& c) {
 * Compound assignment operators for basic_interval                                                 *
 ***************************************************************************************************/
 
+namespace detail {
+
+// minmax4 returns the smallest and largest of four values. It is faster than std::minmax with an
+// initializer_list as the values are not copied into an array.
+template <typename T>
+EZ_CONSTEXPR14 std::pair<T, T> minmax4(T const& a, T const& b, T const& c, T const& d) {
+	return {std::min(std::min(a, b), std::min(c, d)), std::max(std::max(a, b), std::max(c, d))};
+}
+
+}
+
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen>& operator+=(basic_interval<T, LOpen, ROpen>& l,
                                             basic_interval<T, LOpen, ROpen> const& r) {
 	l.assign(l.lower() + r.lower(), l.upper() + r.upper());
@@ -302,7 +484,7 @@ basic_interval<T, LOpen, ROpen>& operator+=(basic_interval<T, LOpen, ROpen>& l,
 }
 
 template <typename T, bool LOpen, bool ROpen>
-basic_interval<T, LOpen, ROpen>&
+EZ_CONSTEXPR14 basic_interval<T, LOpen, ROpen>&
   operator+=(basic_interval<T, LOpen, ROpen>& l,
              typename basic_interval<T, LOpen, ROpen>::difference_type const& d) {
 	l.assign(l.lower() + d, l.upper() + d);
@@ -310,6 +492,7 @@ basic_interval<T, LOpen, ROpen>&
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> operator-=(basic_interval<T, LOpen, ROpen>& l,
                                            basic_interval<T, ROpen, LOpen> const& r) {
 	l.assign(l.lower() - r.upper(), l.upper() - r.lower());
@@ -317,7 +500,7 @@ basic_interval<T, LOpen, ROpen> operator-=(basic_interval<T, LOpen, ROpen>& l,
 }
 
 template <typename T, bool LOpen, bool ROpen>
-basic_interval<T, LOpen, ROpen>&
+EZ_CONSTEXPR14 basic_interval<T, LOpen, ROpen>&
   operator-=(basic_interval<T, LOpen, ROpen>& l,
              typename basic_interval<T, LOpen, ROpen>::difference_type const& d) {
 	l.assign(l.lower() - d, l.upper() - d);
@@ -325,110 +508,156 @@ basic_interval<T, LOpen, ROpen>&
 }
 
 template <typename T, bool Open>
+EZ_CONSTEXPR14
 basic_interval<T, Open, Open>& operator*=(basic_interval<T, Open, Open>& l,
                                           basic_interval<T, Open, Open> const& r) {
-	auto const result = std::minmax({l.lower() * r.lower(), l.lower() * r.upper(),
-	                                 l.upper() * r.lower(), l.upper() * r.upper()});
+	auto const result = detail::minmax4(l.lower() * r.lower(), l.lower() * r.upper(),
+	                                    l.upper() * r.lower(), l.upper() * r.upper());
 	l.assign(result.first, result.second);
 	return l;
 }
 
+// Scaling by a negative value swaps the bounds, which is only possible when both bounds have the
+// same openness, so the other intervals throw empty_interval
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen>& operator*=(basic_interval<T, LOpen, ROpen>& l, T const& d) {
 	l.assign(l.lower() * d, l.upper() * d);
 	return l;
 }
 
+// Multiplying by zero gives [0, 0] as for interval, which is empty if Open is true
 template <typename T, bool Open>
+EZ_CONSTEXPR14
+basic_interval<T, Open, Open>& operator*=(basic_interval<T, Open, Open>& l, T const& d) {
+	auto const zero = T{0};
+	if(d == zero) {
+		l.assign(zero, zero);
+	} else if(d < zero) {
+		l.assign(l.upper() * d, l.lower() * d);
+	} else {
+		l.assign(l.lower() * d, l.upper() * d);
+	}
+
+	return l;
+}
+
+template <typename T, bool Open>
+EZ_CONSTEXPR14
 basic_interval<T, Open, Open>& operator/=(basic_interval<T, Open, Open>& l,
                                           basic_interval<T, Open, Open> const& r) {
 	if(contains(r, 0)) {
-		throw divide_by_zero{};
+		EZ_THROW(divide_by_zero{});
 	}
 
-	auto const result = std::minmax({l.lower() / r.lower(), l.lower() / r.upper(),
-	                                 l.upper() / r.lower(), l.upper() / r.upper()});
+	auto const result = detail::minmax4(l.lower() / r.lower(), l.lower() / r.upper(),
+	                                    l.upper() / r.lower(), l.upper() / r.upper());
 	l.assign(result.first, result.second);
 	return l;
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen>& operator/=(basic_interval<T, LOpen, ROpen>& l, T const& d) {
 	if(d == T{0}) {
-		throw divide_by_zero{};
+		EZ_THROW(divide_by_zero{});
 	}
 
 	l.assign(l.lower() / d, l.upper() / d);
 	return l;
 }
 
+template <typename T, bool Open>
+EZ_CONSTEXPR14
+basic_interval<T, Open, Open>& operator/=(basic_interval<T, Open, Open>& l, T const& d) {
+	auto const zero = T{0};
+	if(d == zero) {
+		EZ_THROW(divide_by_zero{});
+	}
+
+	if(d < zero) {
+		l.assign(l.upper() / d, l.lower() / d);
+	} else {
+		l.assign(l.lower() / d, l.upper() / d);
+	}
+
+	return l;
+}
+
 /***************************************************************************************************
 * Arithmetic operators that return a basic_interval                                                *
 ***************************************************************************************************/
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> operator+(basic_interval<T, LOpen, ROpen> l,
                                           basic_interval<T, LOpen, ROpen> const& r) {
 	return l += r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-basic_interval<T, LOpen, ROpen>
+EZ_CONSTEXPR14 basic_interval<T, LOpen, ROpen>
   operator+(basic_interval<T, LOpen, ROpen> l,
             typename basic_interval<T, LOpen, ROpen>::difference_type const& d) {
 	return l += d;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-basic_interval<T, LOpen, ROpen>
+EZ_CONSTEXPR14 basic_interval<T, LOpen, ROpen>
   operator+(typename basic_interval<T, LOpen, ROpen>::difference_type const& d,
             basic_interval<T, LOpen, ROpen> l) {
 	return l += d;
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> operator-(basic_interval<T, LOpen, ROpen> l,
                                           basic_interval<T, ROpen, LOpen> const& r) {
 	return l -= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-basic_interval<T, LOpen, ROpen>
+EZ_CONSTEXPR14 basic_interval<T, LOpen, ROpen>
   operator-(basic_interval<T, LOpen, ROpen> l,
             typename basic_interval<T, LOpen, ROpen>::difference_type const& d) {
 	return l -= d;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-basic_interval<T, LOpen, ROpen>
+EZ_CONSTEXPR14 basic_interval<T, LOpen, ROpen>
   operator-(typename basic_interval<T, LOpen, ROpen>::difference_type const& d,
             basic_interval<T, LOpen, ROpen> l) {
 	return l -= d;
 }
 
 template <typename T, bool Open>
+EZ_CONSTEXPR14
 basic_interval<T, Open, Open> operator*(basic_interval<T, Open, Open> l,
                                         basic_interval<T, Open, Open> const& r) {
 	return l *= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> operator*(basic_interval<T, LOpen, ROpen> l, T const& d) {
 	return l *= d;
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> operator*(T const& d, basic_interval<T, LOpen, ROpen> l) {
 	return l *= d;
 }
 
 template <typename T, bool Open>
+EZ_CONSTEXPR14
 basic_interval<T, Open, Open> operator/(basic_interval<T, Open, Open> l,
                                         basic_interval<T, Open, Open> const& r) {
 	return l /= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> operator/(basic_interval<T, LOpen, ROpen> l, T const& d) {
 	return l /= d;
 }
@@ -467,33 +696,54 @@ public:
 	typedef T type;
 	typedef typename direct_iterator<T>::difference_type difference_type;
 
+	/** The iterator type is counted_iterator<T> if T supports random access and is not a floating
+	 *  point type, and direct_iterator<T> otherwise. */
+	typedef typename detail::interval_iteration<T>::iterator iterator;
+	typedef iterator const_iterator;
+
+	// The constructors that check for empty intervals do so in an initializer, as in
+	// basic_interval, so that they are constexpr
 	template <bool LOpen, bool ROpen>
-	interval(basic_interval<T, LOpen, ROpen> const& r)
-	: m_lower{r.lower()}
+	constexpr interval(basic_interval<T, LOpen, ROpen> const& r)
+	: m_lower{detail::check<empty_interval>(detail::valid(r.lower(), r.upper(), LOpen, ROpen),
+	                                        r.lower())}
 	, m_upper{r.upper()}
 	, m_openness{static_cast<ez::openness>(LOpen * ez::left_open + ROpen * ez::right_open)} {
-		if(!detail::valid(m_lower, m_upper, LOpen, ROpen)) {
-			throw empty_interval{};
-		}
 	}
 
-	interval(T const& lower, T const& upper, ez::openness o)
-	: m_lower{lower}
+	constexpr interval(T const& lower, T const& upper, ez::openness o)
+	: m_lower{detail::check<empty_interval>(
+	    detail::valid(lower, upper, (o & ez::left_open) != 0, (o & ez::right_open) != 0), lower)}
 	, m_upper{upper}
 	, m_openness{o} {
-		if(!detail::valid(m_lower, m_upper, left_open(), right_open())) {
-			throw empty_interval{};
-		}
 	}
 
-	interval(T const& lower, T const& upper, bool left_open, bool right_open)
-	: m_lower{lower}
+	constexpr interval(T const& lower, T const& upper, bool left_open, bool right_open)
+	: m_lower{detail::check<empty_interval>(detail::valid(lower, upper, left_open, right_open),
+	                                        lower)}
 	, m_upper{upper}
 	, m_openness{left_open ? (right_open ? ez::open : ez::left_open)
 	                       : (right_open ? ez::right_open : ez::closed)} {
-		if(!detail::valid(m_lower, m_upper, left_open, right_open)) {
-			throw empty_interval{};
-		}
+	}
+
+	/** Constructs the interval without checking that it is non-empty, except with assert(). The
+	 *  behaviour is undefined if it is empty. */
+	constexpr interval(T const& lower, T const& upper, bool left_open, bool right_open, unchecked_t)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: m_lower{detail::assume_valid(lower, upper, left_open, right_open)}
+	, m_upper{upper}
+	, m_openness{static_cast<ez::openness>(ez::left_open * left_open +
+	                                       ez::right_open * right_open)} {
+	}
+
+	// Constructs the interval without any check, for placeholder values that may be empty
+	constexpr interval(T const& lower, T const& upper, bool left_open, bool right_open,
+	                   detail::unchecked_tag)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: m_lower{lower}
+	, m_upper{upper}
+	, m_openness{static_cast<ez::openness>(ez::left_open * left_open +
+	                                       ez::right_open * right_open)} {
 	}
 
 	interval(interval<T> const&) = default;
@@ -510,65 +760,81 @@ public:
 	interval<T>& operator=(interval<T> const&) = default;
 	interval<T>& operator=(interval<T>&&) = default;
 
-	T const& lower() const noexcept {
+	constexpr T const& lower() const noexcept {
 		return m_lower;
 	}
 
-	T const& upper() const noexcept {
+	constexpr T const& upper() const noexcept {
 		return m_upper;
 	}
 
-	void assign(T const& lower, T const& upper) {
-		if(!detail::valid(m_lower, m_upper, left_open(), right_open())) {
-			throw empty_interval{};
+	EZ_CONSTEXPR14 void assign(T const& lower, T const& upper) {
+		if(!detail::valid(lower, upper, left_open(), right_open())) {
+			EZ_THROW(empty_interval{});
 		}
 
 		m_lower = lower;
 		m_upper = upper;
 	}
 
-	void set_open(bool left_open, bool right_open) {
+	/** Sets the bounds without checking that the interval is non-empty, except with assert(). */
+	EZ_CONSTEXPR14 void assign(T const& lower, T const& upper, unchecked_t)
+	  noexcept(std::is_nothrow_copy_assignable<T>::value) {
+		assert(detail::valid(lower, upper, left_open(), right_open()));
+		m_lower = lower;
+		m_upper = upper;
+	}
+
+	EZ_CONSTEXPR14 void set_open(bool left_open, bool right_open) {
 		if(!detail::valid(m_lower, m_upper, left_open, right_open)) {
-			throw empty_interval{};
+			EZ_THROW(empty_interval{});
 		}
 
 		m_openness = static_cast<openness>(ez::left_open * left_open +
 		                                   ez::right_open * right_open);
 	}
 
-	bool left_open() const noexcept {
+	constexpr bool left_open() const noexcept {
 		return m_openness & ez::left_open;
 	}
 
-	bool left_closed() const noexcept {
+	constexpr bool left_closed() const noexcept {
 		return !left_open();
 	}
 
-	bool right_open() const noexcept {
+	constexpr bool right_open() const noexcept {
 		return m_openness & ez::right_open;
 	}
 
-	bool right_closed() const noexcept {
+	constexpr bool right_closed() const noexcept {
 		return !right_open();
 	}
 
-	direct_iterator<T> begin() const {
-		return make_direct_iterator(detail::next_if_true(m_lower, left_open()));
+	/** Returns the number of elements in this interval in O(1). This is only available if the
+	 *  iterator_category of direct_iterator<T> is random access. */
+	constexpr difference_type size() const {
+		return detail::size<difference_type>(m_lower, m_upper, left_open(), right_open());
+	}
+
+	EZ_CONSTEXPR14 iterator begin() const {
+		return iteration::begin(m_lower, m_upper, left_open(), right_open());
 	}
 
-	direct_iterator<T> end() const {
-		return make_direct_iterator(detail::next_if_true(m_upper, right_closed()));
+	EZ_CONSTEXPR14 iterator end() const {
+		return iteration::end(m_lower, m_upper, left_open(), right_open());
 	}
 
-	direct_iterator<T> cbegin() const {
-		return make_direct_iterator(detail::next_if_true(m_lower, left_open()));
+	EZ_CONSTEXPR14 iterator cbegin() const {
+		return begin();
 	}
 
-	direct_iterator<T> cend() const {
-		return make_direct_iterator(detail::next_if_true(m_upper, right_closed()));
+	EZ_CONSTEXPR14 iterator cend() const {
+		return end();
 	}
 
 private:
+	typedef detail::interval_iteration<T> iteration;
+
 	T m_lower;
 	T m_upper;
 	openness m_openness;
@@ -582,36 +848,111 @@ struct is_interval<interval<T>> : std::true_type {
 * Compound assignment operators for interval                                                       *
 ***************************************************************************************************/
 
+namespace detail {
+
+// The try_ functions below compute the arithmetic operators for interval without throwing. They
+// return false, leaving l unchanged, if the result would be empty, which only happens if a bound
+// is NaN. The operators throw when they fail, and ez/checked.hpp returns an error instead.
+
+template <typename T>
+EZ_CONSTEXPR14 bool try_assign(interval<T>& l, typename interval<T>::type const& lower,
+                               typename interval<T>::type const& upper, bool left_open,
+                               bool right_open) {
+	if(!valid(lower, upper, left_open, right_open)) {
+		return false;
+	}
+
+	l = interval<T>{lower, upper, left_open, right_open, unchecked_tag{}};
+	return true;
+}
+
 template <typename T, typename Interval>
-interval<T>& operator+=(interval<T>& l, Interval const& r) {
+EZ_CONSTEXPR14 bool try_add(interval<T>& l, Interval const& r) {
 	static_assert(std::is_same<T, typename Interval::type>::value,
 	              "Underlying types of intervals must be equal");
-	l.assign(l.lower() + r.lower(), l.upper() + r.upper());
-	l.set_open(l.left_open() || r.left_open(), l.right_open() || r.right_open());
+	return try_assign(l, l.lower() + r.lower(), l.upper() + r.upper(),
+	                  l.left_open() || r.left_open(), l.right_open() || r.right_open());
+}
+
+template <typename T, typename Interval>
+EZ_CONSTEXPR14 bool try_subtract(interval<T>& l, Interval const& r) {
+	static_assert(std::is_same<T, typename Interval::type>::value,
+	              "Underlying types of intervals must be equal");
+	return try_assign(l, l.lower() - r.upper(), l.upper() - r.lower(),
+	                  l.left_open() || r.right_open(), l.right_open() || r.left_open());
+}
+
+template <typename T>
+EZ_CONSTEXPR14 bool try_shift(interval<T>& l, typename interval<T>::difference_type const& d) {
+	return try_assign(l, l.lower() + d, l.upper() + d, l.left_open(), l.right_open());
+}
+
+// try_scale sets l to l * d, or to l / d if Divide is true. A negative d swaps the bounds, and
+// multiplying by zero gives the interval [0, 0].
+template <bool Divide, typename T>
+EZ_CONSTEXPR14 bool try_scale(interval<T>& l, T const& d) {
+	auto const zero = T{0};
+	if(!Divide && d == zero) {
+		return try_assign(l, zero, zero, false, false);
+	}
+
+	T const lower = Divide ? l.lower() / d : l.lower() * d;
+	T const upper = Divide ? l.upper() / d : l.upper() * d;
+	if(d < zero) {
+		return try_assign(l, upper, lower, l.right_open(), l.left_open());
+	}
+
+	return try_assign(l, lower, upper, l.left_open(), l.right_open());
+}
+
+}
+
+template <typename T, typename Interval>
+EZ_CONSTEXPR14 interval<T>& operator+=(interval<T>& l, Interval const& r) {
+	if(!detail::try_add(l, r)) {
+		EZ_THROW(empty_interval{});
+	}
+
 	return l;
 }
 
 template <typename T>
+EZ_CONSTEXPR14
 interval<T>& operator+=(interval<T>& l, typename interval<T>::difference_type const& d) {
-	l.assign(l.lower() + d, l.upper() + d);
+	if(!detail::try_shift(l, d)) {
+		EZ_THROW(empty_interval{});
+	}
+
 	return l;
 }
 
 template <typename T, typename Interval>
-interval<T>& operator-=(interval<T>& l, Interval const& r) {
-	l.assign(l.lower() - r.upper(), l.upper() - r.lower());
-	l.set_open(l.left_open() || r.right_open(), l.right_open() || r.left_open());
+EZ_CONSTEXPR14 interval<T>& operator-=(interval<T>& l, Interval const& r) {
+	if(!detail::try_subtract(l, r)) {
+		EZ_THROW(empty_interval{});
+	}
+
 	return l;
 }
 
 template <typename T>
+EZ_CONSTEXPR14
 interval<T>& operator-=(interval<T>& l, typename interval<T>::difference_type const& d) {
-	l.assign(l.lower() - d, l.upper() - d);
+	if(!detail::try_assign(l, l.lower() - d, l.upper() - d, l.left_open(), l.right_open())) {
+		EZ_THROW(empty_interval{});
+	}
+
 	return l;
 }
 
+namespace detail {
+
+// general_multiply and general_divide choose the bounds of the result from all four candidates
+// with std::min and std::max. They handle candidates that are zero or NaN, where the openness of
+// the result depends on the values of the bounds and not only on their openness.
+
 template <typename T>
-interval<T>& operator*=(interval<T>& l, interval<T> const& r) {
+EZ_CONSTEXPR14 bool general_multiply(interval<T>& l, interval<T> const& r) {
 	// We need to sort using the openness because if two values are equal, we want the one that
 	// is closed and min(true, false) = false;
 	auto const zero = T{0};
@@ -630,60 +971,200 @@ interval<T>& operator*=(interval<T>& l, interval<T> const& r) {
 	                                        (r.right_open() && l.upper() != zero))
 	};
 
-	auto lower = std::min(choices);
-	auto upper = std::max(choices, detail::lt_first_gt_second<T, bool>);
+	auto const lower = std::min(choices);
+	auto const upper = std::max(choices, detail::lt_first_gt_second<T, bool>);
+	return try_assign(l, lower.first, upper.first, lower.second, upper.second);
+}
+
+template <typename T>
+EZ_CONSTEXPR14 bool general_divide(interval<T>& l, interval<T> const& r) {
+	// We need to sort using the openness because if two values are equal, we want the one that
+	// is closed and min(true, false) = false;
+	auto const zero = T{0};
+	auto const choices = {
+	  std::make_pair(l.lower() / r.lower(), l.lower() != zero && (l.left_open() || r.left_open())),
+	  std::make_pair(l.lower() / r.upper(), l.lower() != zero && (l.left_open() || r.right_open())),
+	  std::make_pair(l.upper() / r.lower(), l.upper() != zero && (l.right_open() || r.left_open())),
+	  std::make_pair(l.upper() / r.upper(), l.upper() != zero && (l.right_open() || r.right_open()))
+	};
+
+	auto const lower = std::min(choices);
+	auto const upper = std::max(choices, detail::lt_first_gt_second<T, bool>);
+	return try_assign(l, lower.first, upper.first, lower.second, upper.second);
+}
+
+// nonzero returns true if value is neither zero nor NaN
+template <typename T>
+constexpr bool nonzero(T const& value) {
+	return (value < T{0}) | (value > T{0});
+}
+
+// either returns a || b without branching
+constexpr bool either(bool a, bool b) noexcept {
+	return a | b;
+}
+
+// sign_class returns 0 if both bounds of r are negative, 1 if only the upper bound is positive, and
+// 2 if both bounds are positive. Neither bound may be zero.
+template <typename T>
+constexpr unsigned sign_class(interval<T> const& r) {
+	return static_cast<unsigned>(r.lower() > T{0}) + static_cast<unsigned>(r.upper() > T{0});
+}
+
+// extremes holds the indices of the two candidates that may be the lower bound of a result, and the
+// two that may be the upper bound. The candidates are the lower and upper bounds of the left hand
+// side combined with the lower and upper bounds of the right hand side, in the order ll, lu, ul, uu.
+struct extremes {
+	unsigned char lower[2];
+	unsigned char upper[2];
+};
+
+// assign_extremes sets l to the bounds picked by e from the candidates c, which must all be
+// non-zero and not NaN, so that open[i] is whether c[i] would be an open bound. A bound is closed if
+// any candidate equal to it is closed, which is how the general path breaks ties. It returns false
+// if the result would be empty.
+template <typename T>
+EZ_CONSTEXPR14
+bool assign_extremes(interval<T>& l, T const (&c)[4], bool const (&open)[4], extremes const& e) {
+	auto const& lower = c[e.lower[1]] < c[e.lower[0]] ? c[e.lower[1]] : c[e.lower[0]];
+	auto const& upper = c[e.upper[0]] < c[e.upper[1]] ? c[e.upper[1]] : c[e.upper[0]];
+	auto lower_open = true;
+	auto upper_open = true;
+	for(auto i = 0; i < 4; ++i) {
+		lower_open = lower_open & (open[i] | (c[i] != lower));
+		upper_open = upper_open & (open[i] | (c[i] != upper));
+	}
+
+	// The same as valid(), without branching on the openness
+	if(!((lower < upper) | ((lower == upper) & !lower_open & !upper_open))) {
+		return false;
+	}
+
+	l = interval<T>{lower, upper, lower_open, upper_open, unchecked_tag{}};
+	return true;
+}
+
+// sign_tables holds the candidates picked by operator*= and operator/= for the sign classes of
+// their arguments. They are static members of a class template so that they are defined once
+// and can be read in constant expressions.
+template <typename = void>
+struct sign_tables {
+	static constexpr extremes multiply[3][3] = {
+	  {{{3, 3}, {0, 0}}, {{1, 1}, {0, 0}}, {{1, 1}, {2, 2}}},
+	  {{{2, 2}, {0, 0}}, {{1, 2}, {0, 3}}, {{1, 1}, {3, 3}}},
+	  {{{2, 2}, {1, 1}}, {{2, 2}, {3, 3}}, {{0, 0}, {3, 3}}}
+	};
+
+	// r cannot contain zero so its sign class is never 1
+	static constexpr extremes divide[3][3] = {
+	  {{{2, 2}, {1, 1}}, {{0, 0}, {0, 0}}, {{0, 0}, {3, 3}}},
+	  {{{3, 3}, {1, 1}}, {{0, 0}, {0, 0}}, {{0, 0}, {2, 2}}},
+	  {{{3, 3}, {0, 0}}, {{0, 0}, {0, 0}}, {{1, 1}, {2, 2}}}
+	};
+};
+
+template <typename Unused>
+constexpr extremes sign_tables<Unused>::multiply[3][3];
+
+template <typename Unused>
+constexpr extremes sign_tables<Unused>::divide[3][3];
+
+// try_multiply sets l to l * r
+template <typename T>
+EZ_CONSTEXPR14 bool try_multiply(interval<T>& l, interval<T> const& r) {
+	T const c[] = {l.lower() * r.lower(), l.lower() * r.upper(),
+	               l.upper() * r.lower(), l.upper() * r.upper()};
+	if(!(nonzero(c[0]) & nonzero(c[1]) & nonzero(c[2]) & nonzero(c[3]))) {
+		return general_multiply(l, r);
+	}
+
+	// No bound is zero, so a candidate is open if either of its bounds is open, and the signs of
+	// the bounds decide which candidates are the smallest and largest
+	bool const open[] = {either(l.left_open(), r.left_open()),
+	                     either(l.left_open(), r.right_open()),
+	                     either(l.right_open(), r.left_open()),
+	                     either(l.right_open(), r.right_open())};
+	return assign_extremes(l, c, open, sign_tables<>::multiply[sign_class(l)][sign_class(r)]);
+}
+
+// divides_by_zero returns true if r contains zero, including as an open bound
+template <typename T, typename Interval>
+constexpr bool divides_by_zero(Interval const& r) {
+	return (r.lower() <= T{0}) & (r.upper() >= T{0});
+}
+
+// try_divide sets l to l / r, where r must not contain zero
+template <typename T>
+EZ_CONSTEXPR14 bool try_divide(interval<T>& l, interval<T> const& r) {
+	T const c[] = {l.lower() / r.lower(), l.lower() / r.upper(),
+	               l.upper() / r.lower(), l.upper() / r.upper()};
+	if(!(nonzero(c[0]) & nonzero(c[1]) & nonzero(c[2]) & nonzero(c[3]))) {
+		return general_divide(l, r);
+	}
+
+	// As for try_multiply
+	bool const open[] = {either(l.left_open(), r.left_open()),
+	                     either(l.left_open(), r.right_open()),
+	                     either(l.right_open(), r.left_open()),
+	                     either(l.right_open(), r.right_open())};
+	return assign_extremes(l, c, open, sign_tables<>::divide[sign_class(l)][sign_class(r)]);
+}
+
+}
+
+template <typename T>
+EZ_CONSTEXPR14 interval<T>& operator*=(interval<T>& l, interval<T> const& r) {
+	if(!detail::try_multiply(l, r)) {
+		EZ_THROW(empty_interval{});
+	}
 
-	l.assign(lower.first, upper.first);
-	l.set_open(lower.second, upper.second);
 	return l;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T>& operator*=(interval<T>& l, basic_interval<T, LOpen, ROpen> const& r) {
+EZ_CONSTEXPR14 interval<T>& operator*=(interval<T>& l, basic_interval<T, LOpen, ROpen> const& r) {
 	return l *= ez::interval<T>{r};
 }
 
 template <typename T>
-interval<T>& operator*=(interval<T>& l, T const& d) {
-	l.assign(l.lower() * d, l.upper() * d);
+EZ_CONSTEXPR14
+interval<T>& operator*=(interval<T>& l, typename interval<T>::type const& d) {
+	if(!detail::try_scale<false>(l, d)) {
+		EZ_THROW(empty_interval{});
+	}
+
 	return l;
 }
 
 template <typename T>
-interval<T>& operator/=(interval<T>& l, interval<T> const& r) {
-	auto const zero = T{0};
-	if(contains(make_closed(r), zero)) {
-		throw ez::divide_by_zero{};
+EZ_CONSTEXPR14 interval<T>& operator/=(interval<T>& l, interval<T> const& r) {
+	if(detail::divides_by_zero<T>(r)) {
+		EZ_THROW(divide_by_zero{});
 	}
 
-	// We need to sort using the openness because if two values are equal, we want the one that
-	// is closed and min(true, false) = false;
-	auto const choices = {
-	  std::make_pair(l.lower() / r.lower(), l.lower() != zero && (l.left_open() || r.left_open())),
-	  std::make_pair(l.lower() / r.upper(), l.lower() != zero && (l.left_open() || r.right_open())),
-	  std::make_pair(l.upper() / r.lower(), l.upper() != zero && (l.right_open() || r.left_open())),
-	  std::make_pair(l.upper() / r.upper(), l.upper() != zero && (l.right_open() || r.right_open()))
-	};
+	if(!detail::try_divide(l, r)) {
+		EZ_THROW(empty_interval{});
+	}
 
-	auto const lower = std::min(choices);
-	auto const upper = std::max(choices, detail::lt_first_gt_second<T, bool>);
-	l.assign(lower.first, upper.first);
-	l.set_open(lower.second, upper.second);
 	return l;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T>& operator/=(interval<T>& l, basic_interval<T, LOpen, ROpen> const& r) {
+EZ_CONSTEXPR14 interval<T>& operator/=(interval<T>& l, basic_interval<T, LOpen, ROpen> const& r) {
 	return l /= ez::interval<T>{r};
 }
 
 template <typename T>
-interval<T>& operator/=(interval<T>& l, T const& d) {
+EZ_CONSTEXPR14
+interval<T>& operator/=(interval<T>& l, typename interval<T>::type const& d) {
 	if(d == T{0}) {
-		throw ez::divide_by_zero{};
+		EZ_THROW(divide_by_zero{});
+	}
+
+	if(!detail::try_scale<true>(l, d)) {
+		EZ_THROW(empty_interval{});
 	}
 
-	l.assign(l.lower() / d, l.upper() / d);
 	return l;
 }
 
@@ -692,21 +1173,22 @@ interval<T>& operator/=(interval<T>& l, T const& d) {
 ***************************************************************************************************/
 
 template <typename T>
-interval<T> operator+(interval<T> l, interval<T> const& r) {
+EZ_CONSTEXPR14 interval<T> operator+(interval<T> l, interval<T> const& r) {
 	return l += r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T> operator+(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
+EZ_CONSTEXPR14 interval<T> operator+(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
 	return l += r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T> operator+(basic_interval<T, LOpen, ROpen> const& l, interval<T> r) {
+EZ_CONSTEXPR14 interval<T> operator+(basic_interval<T, LOpen, ROpen> const& l, interval<T> r) {
 	return r += l;
 }
 
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 interval<T> operator+(basic_interval<T, LOpen1, ROpen1> l,
                       basic_interval<T, LOpen2, ROpen2> const& r) {
 	interval<T> x{std::move(l)};
@@ -714,31 +1196,34 @@ interval<T> operator+(basic_interval<T, LOpen1, ROpen1> l,
 }
 
 template <typename T>
+EZ_CONSTEXPR14
 interval<T> operator+(interval<T> l, typename interval<T>::difference_type const& d) {
 	return l += d;
 }
 
 template <typename T>
+EZ_CONSTEXPR14
 interval<T> operator+(typename interval<T>::difference_type const& d, interval<T> l) {
 	return l += d;
 }
 
 template <typename T>
-interval<T> operator-(interval<T> l, interval<T> const& r) {
+EZ_CONSTEXPR14 interval<T> operator-(interval<T> l, interval<T> const& r) {
 	return l -= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T> operator-(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
+EZ_CONSTEXPR14 interval<T> operator-(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
 	return l -= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T> operator-(basic_interval<T, LOpen, ROpen> const& l, interval<T> r) {
+EZ_CONSTEXPR14 interval<T> operator-(basic_interval<T, LOpen, ROpen> const& l, interval<T> r) {
 	return r -= l;
 }
 
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 interval<T> operator-(basic_interval<T, LOpen1, ROpen1> l,
                       basic_interval<T, LOpen2, ROpen2> const& r) {
 	interval<T> x{std::move(l)};
@@ -746,27 +1231,30 @@ interval<T> operator-(basic_interval<T, LOpen1, ROpen1> l,
 }
 
 template <typename T>
+EZ_CONSTEXPR14
 interval<T> operator-(interval<T> l, typename interval<T>::difference_type const& d) {
 	return l -= d;
 }
 
 template <typename T>
-interval<T> operator*(interval<T> l, interval<T> const& r) {
+EZ_CONSTEXPR14 interval<T> operator*(interval<T> l, interval<T> const& r) {
 	return l *= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T> operator*(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
+EZ_CONSTEXPR14 interval<T> operator*(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
 	return l *= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 interval<T> operator*(basic_interval<T, LOpen, ROpen> const& l, interval<T> const& r) {
 	ez::interval<T> tmp = l;
 	return tmp *= r;
 }
 
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 interval<T> operator*(basic_interval<T, LOpen1, ROpen1> const& l,
                       basic_interval<T, LOpen2, ROpen2> const& r) {
 	ez::interval<T> tmp = l;
@@ -774,32 +1262,36 @@ interval<T> operator*(basic_interval<T, LOpen1, ROpen1> const& l,
 }
 
 template <typename T>
-interval<T> operator*(interval<T> l, typename interval<T>::difference_type const& d) {
+EZ_CONSTEXPR14
+interval<T> operator*(interval<T> l, typename interval<T>::type const& d) {
 	return l *= d;
 }
 
 template <typename T>
-interval<T> operator*(typename interval<T>::difference_type const& d, interval<T> l) {
+EZ_CONSTEXPR14
+interval<T> operator*(typename interval<T>::type const& d, interval<T> l) {
 	return l *= d;
 }
 
 template <typename T>
-interval<T> operator/(interval<T> l, interval<T> const& r) {
+EZ_CONSTEXPR14 interval<T> operator/(interval<T> l, interval<T> const& r) {
 	return l /= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
-interval<T> operator/(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
+EZ_CONSTEXPR14 interval<T> operator/(interval<T> l, basic_interval<T, LOpen, ROpen> const& r) {
 	return l /= r;
 }
 
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 interval<T> operator/(basic_interval<T, LOpen, ROpen> const& l, interval<T> const& r) {
 	ez::interval<T> tmp = l;
 	return tmp /= r;
 }
 
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 interval<T> operator/(basic_interval<T, LOpen1, ROpen1> const& l,
                       basic_interval<T, LOpen2, ROpen2> const& r) {
 	ez::interval<T> tmp = l;
@@ -807,7 +1299,8 @@ interval<T> operator/(basic_interval<T, LOpen1, ROpen1> const& l,
 }
 
 template <typename T>
-interval<T> operator/(interval<T> l, typename interval<T>::difference_type const& d) {
+EZ_CONSTEXPR14
+interval<T> operator/(interval<T> l, typename interval<T>::type const& d) {
 	return l /= d;
 }
 
@@ -818,7 +1311,7 @@ interval<T> operator/(interval<T> l, typename interval<T>::difference_type const
 template <typename Interval1, typename Interval2,
           typename std::enable_if<is_interval<Interval1>::value &&
                                   is_interval<Interval2>::value>::type* = nullptr>
-bool operator==(Interval1 const& lhs, Interval2 const& rhs)
+constexpr bool operator==(Interval1 const& lhs, Interval2 const& rhs)
   noexcept(is_nothrow_totally_ordered<typename Interval1::type>::value) {
 	static_assert(std::is_same<typename Interval1::type, typename Interval2::type>::value,
 	              "Underlying types of intervals must be equal");
@@ -831,7 +1324,7 @@ bool operator==(Interval1 const& lhs, Interval2 const& rhs)
 template <typename Interval1, typename Interval2,
           typename std::enable_if<is_interval<Interval1>::value &&
                                   is_interval<Interval2>::value>::type* = nullptr>
-bool operator!=(Interval1 const& lhs, Interval2 const& rhs)
+constexpr bool operator!=(Interval1 const& lhs, Interval2 const& rhs)
   noexcept(is_nothrow_totally_ordered<typename Interval1::type>::value) {
 	return !(lhs == rhs);
 }
@@ -839,19 +1332,20 @@ bool operator!=(Interval1 const& lhs, Interval2 const& rhs)
 /** Returns true if \a r contains only one element. */
 template <typename Interval,
           typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
-bool singleton(Interval const& r)
+constexpr bool singleton(Interval const& r)
   noexcept(is_nothrow_totally_ordered<typename Interval::type>::value) {
 	return r.left_closed() && r.right_closed() && (r.lower() == r.upper());
 }
 
 /** Converts an interval with underlying type To to an interval of underlying type From. */
 template <typename To, typename From>
-interval<To> interval_cast(interval<From> const& r) {
+constexpr interval<To> interval_cast(interval<From> const& r) {
 	return {static_cast<To>(r.lower()), static_cast<To>(r.upper()), r.left_open(), r.right_open()};
 }
 
 /** Converts a basic_interval with underlying type To to an interval of underlying type From. */
 template <typename To, typename From, bool LOpen, bool ROpen>
+constexpr
 basic_interval<To, LOpen, ROpen> interval_cast(basic_interval<From, LOpen, ROpen> const& r) {
 	return {static_cast<To>(r.lower()), static_cast<To>(r.upper())};
 }
@@ -859,7 +1353,7 @@ basic_interval<To, LOpen, ROpen> interval_cast(basic_interval<From, LOpen, ROpen
 /** Returns the difference between the upper and lower bounds of \a r. */
 template <typename Interval, typename U = typename Interval::type,
           typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
-U diameter(Interval const& r) {
+constexpr U diameter(Interval const& r) {
 	return static_cast<U>(r.upper()) - static_cast<U>(r.lower());
 }
 
@@ -877,7 +1371,7 @@ U diameter(Interval const& r) {
 template <typename U = void, typename Interval,
           typename std::enable_if<is_interval<Interval>::value>::type* = nullptr,
           typename Return = typename detail::first_non_void<U, typename Interval::type>::type>
-Return midpoint(Interval const& r) {
+constexpr Return midpoint(Interval const& r) {
 	return static_cast<Return>(r.lower()) +
 	  (static_cast<Return>(r.upper()) - static_cast<Return>(r.lower())) / 2;
 }
@@ -894,14 +1388,14 @@ Return midpoint(Interval const& r) {
 template <typename U = void, typename Interval,
           typename std::enable_if<is_interval<Interval>::value>::type* = nullptr,
           typename Return = typename detail::first_non_void<U, typename Interval::type>::type>
-Return radius(Interval const& r) {
+constexpr Return radius(Interval const& r) {
 	return static_cast<Return>(diameter(r)) / 2;
 }
 
 /** Returns true if \a value is within the interval \a r. */
 template <typename Interval,
           typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
-bool contains(Interval const& r, typename Interval::type const& value)
+constexpr bool contains(Interval const& r, typename Interval::type const& value)
   noexcept(is_nothrow_totally_ordered<typename Interval::type>::value) {
 	return (r.left_open()  ? r.lower() < value : r.lower() <= value) &&
 	       (r.right_open() ? r.upper() > value : r.upper() >= value);
@@ -915,7 +1409,7 @@ bool contains(Interval const& r, typename Interval::type const& value)
  *  \endcode */
 template <typename Interval,
           typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
-closed_interval<typename Interval::type> make_closed(Interval const& r) {
+constexpr closed_interval<typename Interval::type> make_closed(Interval const& r) {
 	return {r.lower(), r.upper()};
 }
 
@@ -927,7 +1421,7 @@ closed_interval<typename Interval::type> make_closed(Interval const& r) {
  *  \endcode */
 template <typename Interval,
           typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
-open_interval<typename Interval::type> make_open(Interval const& r) {
+constexpr open_interval<typename Interval::type> make_open(Interval const& r) {
 	return {r.lower(), r.upper()};
 }
 
@@ -961,6 +1455,7 @@ std::ostream& operator<<(std::ostream& stream, basic_interval<T, LOpen, ROpen> c
 template <typename Interval1, typename Interval2,
           typename std::enable_if<is_interval<Interval1>::value &&
                                   is_interval<Interval2>::value>::type* = nullptr>
+EZ_CONSTEXPR14
 interval<typename Interval1::type> intersection(Interval1 const& lhs,
                                                 Interval2 const& rhs) {
 	static_assert(std::is_same<typename Interval1::type, typename Interval2::type>::value,
@@ -984,6 +1479,7 @@ interval<typename Interval1::type> intersection(Interval1 const& lhs,
  *  assert(intersection(a, b) == ez::make_interval[3](6));
  *  \endcode */
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> intersection(basic_interval<T, LOpen, ROpen> const& lhs,
                                              basic_interval<T, LOpen, ROpen> const& rhs) {
 	return {std::max(lhs.lower(), rhs.lower()), std::min(lhs.upper(), rhs.upper())};
@@ -999,7 +1495,7 @@ basic_interval<T, LOpen, ROpen> intersection(basic_interval<T, LOpen, ROpen> con
 template <typename Interval1, typename Interval2,
           typename std::enable_if<is_interval<Interval1>::value &&
                                   is_interval<Interval2>::value>::type* = nullptr>
-interval<typename Interval1::type> hull(Interval1 const& lhs, Interval2 const& rhs)
+EZ_CONSTEXPR14 interval<typename Interval1::type> hull(Interval1 const& lhs, Interval2 const& rhs)
   noexcept(is_nothrow_totally_ordered<typename Interval1::type>::value) {
 	static_assert(std::is_same<typename Interval1::type, typename Interval2::type>::value,
 	              "Underlying types of intervals must be equal");
@@ -1016,6 +1512,7 @@ interval<typename Interval1::type> hull(Interval1 const& lhs, Interval2 const& r
 
 /** Returns the smallest basic_interval containing both \a lhs and \a rhs. */
 template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14
 basic_interval<T, LOpen, ROpen> hull(basic_interval<T, LOpen, ROpen> const& lhs,
                                      basic_interval<T, LOpen, ROpen> const& rhs)
   noexcept(is_nothrow_totally_ordered<T>::value) {
@@ -1024,7 +1521,7 @@ basic_interval<T, LOpen, ROpen> hull(basic_interval<T, LOpen, ROpen> const& lhs,
 
 /** Returns true if \a is a subset of \a b. */
 template <typename T>
-bool subset(interval<T> const& a, interval<T> const& b)
+EZ_CONSTEXPR14 bool subset(interval<T> const& a, interval<T> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
 	auto const lower_strict_comp = a.left_open() || !b.left_open();
 	auto const upper_strict_comp = a.right_open() || !b.right_open();
@@ -1037,6 +1534,7 @@ bool subset(interval<T> const& a, interval<T> const& b)
 
 /** Returns true if \a is a subset of \a b. */
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 bool subset(basic_interval<T, LOpen1, ROpen1> const& a,
             basic_interval<T, LOpen2, ROpen2> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
@@ -1045,13 +1543,14 @@ bool subset(basic_interval<T, LOpen1, ROpen1> const& a,
 
 /** Returns true if \a is a superset of \a b. */
 template <typename T>
-bool superset(interval<T> const& a, interval<T> const& b)
+EZ_CONSTEXPR14 bool superset(interval<T> const& a, interval<T> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
 	return subset(b, a);
 }
 
 /** Returns true if \a is a superset of \a b. */
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 bool superset(basic_interval<T, LOpen1, ROpen1> const& a,
               basic_interval<T, LOpen2, ROpen2> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
@@ -1060,7 +1559,7 @@ bool superset(basic_interval<T, LOpen1, ROpen1> const& a,
 
 /** Returns true if \a is a proper subset (\a is a subset but not equal to \a b) of \a b. */
 template <typename T>
-bool proper_subset(interval<T> const& a, interval<T> const& b)
+EZ_CONSTEXPR14 bool proper_subset(interval<T> const& a, interval<T> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
 	auto const lower_strict_comp = a.left_open() && !b.left_open();
 	auto const upper_strict_comp = a.right_open() && !b.right_open();
@@ -1073,6 +1572,7 @@ bool proper_subset(interval<T> const& a, interval<T> const& b)
 
 /** Returns true if \a is a proper subset (\a is a subset but not equal to \a b) of \a b. */
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 bool proper_subset(basic_interval<T, LOpen1, ROpen1> const& a,
                    basic_interval<T, LOpen2, ROpen2> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
@@ -1081,13 +1581,14 @@ bool proper_subset(basic_interval<T, LOpen1, ROpen1> const& a,
 
 /** Returns true if \a is a proper superset (\a is a superset but not equal to \a b) of \a b. */
 template <typename T>
-bool proper_superset(interval<T> const& a, interval<T> const& b)
+EZ_CONSTEXPR14 bool proper_superset(interval<T> const& a, interval<T> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
 	return proper_subset(b, a);
 }
 
 /** Returns true if \a is a proper superset (\a is a superset but not equal to \a b) of \a b. */
 template <typename T, bool LOpen1, bool ROpen1, bool LOpen2, bool ROpen2>
+EZ_CONSTEXPR14
 bool proper_superset(basic_interval<T, LOpen1, ROpen1> const& a,
                      basic_interval<T, LOpen2, ROpen2> const& b)
   noexcept(is_nothrow_totally_ordered<T>::value) {
@@ -1139,7 +1640,7 @@ Interval apply_strictly_decreasing(Interval const& r, MonotonicFunction f) {
  *  auto c = ez::make_interval(4)[8];  // Returns ez::left_open<int>
  *  auto d = ez::make_interval(-1)(1); // Returns ez::open_interval<int>
  *  \endcode */
-static detail::interval_factory const make_interval;
+static constexpr detail::interval_factory make_interval{};
 
 }
 
@@ -0,0 +1,656 @@
+/******************************************************************//**
+ * \file   interval_array.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_0A97B41F_035A_4BFE_93E3_1802149B1623
+#define INCLUDE_GUARD_0A97B41F_035A_4BFE_93E3_1802149B1623
+
+#include "ez/interval.hpp"
+#include "ez/simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ez {
+
+/** A size_mismatch exception is thrown when combining two interval arrays of different sizes. */
+struct size_mismatch : std::runtime_error {
+	size_mismatch()
+	: std::runtime_error{"Interval arrays have different sizes"} {
+	}
+};
+
+template <typename T>
+class interval_array;
+
+namespace detail {
+
+// array_columns points to the lower bounds, upper bounds and the bits for the openness of the
+// intervals in an interval_array, with the openness of the i-th interval in bit i % 8 of byte i / 8
+template <typename T, typename Byte>
+struct array_columns {
+	T* lower;
+	T* upper;
+	Byte* left_open;
+	Byte* right_open;
+	std::size_t size;
+};
+
+template <typename T>
+using mutable_columns = array_columns<T, std::uint8_t>;
+
+template <typename T>
+using const_columns = array_columns<T const, std::uint8_t const>;
+
+inline bool get_bit(std::uint8_t const* bits, std::size_t i) noexcept {
+	return (bits[i / 8] >> (i % 8)) & 1u;
+}
+
+inline void set_bit(std::uint8_t* bits, std::size_t i, bool b) noexcept {
+	auto const mask = static_cast<std::uint8_t>(1u << (i % 8));
+	bits[i / 8] = static_cast<std::uint8_t>(b ? (bits[i / 8] | mask) : (bits[i / 8] & ~mask));
+}
+
+template <typename T, typename Byte>
+interval<typename std::remove_const<T>::type> get(array_columns<T, Byte> const& c, std::size_t i) {
+	return {c.lower[i], c.upper[i], get_bit(c.left_open, i), get_bit(c.right_open, i),
+	        unchecked_tag{}};
+}
+
+template <typename T>
+void set(mutable_columns<T> const& c, std::size_t i, interval<T> const& r) {
+	c.lower[i] = r.lower();
+	c.upper[i] = r.upper();
+	set_bit(c.left_open, i, r.left_open());
+	set_bit(c.right_open, i, r.right_open());
+}
+
+// array_access gives the kernels access to the columns of an interval_array
+struct array_access {
+	template <typename T>
+	static mutable_columns<T> columns(interval_array<T>& a) noexcept {
+		return {a.m_lower.data(), a.m_upper.data(), a.m_left_open.data(), a.m_right_open.data(),
+		        a.size()};
+	}
+
+	template <typename T>
+	static const_columns<T> columns(interval_array<T> const& a) noexcept {
+		return {a.m_lower.data(), a.m_upper.data(), a.m_left_open.data(), a.m_right_open.data(),
+		        a.size()};
+	}
+};
+
+// scalar_array_kernels applies the operators of interval<T> to each element from first onwards
+template <typename T>
+struct scalar_array_kernels {
+	static void add(mutable_columns<T> const& l, const_columns<T> const& r, std::size_t first = 0) {
+		for(auto i = first; i < l.size; ++i) {
+			auto x = get(l, i);
+			set(l, i, x += get(r, i));
+		}
+	}
+
+	static void subtract(mutable_columns<T> const& l, const_columns<T> const& r,
+	                     std::size_t first = 0) {
+		for(auto i = first; i < l.size; ++i) {
+			auto x = get(l, i);
+			set(l, i, x -= get(r, i));
+		}
+	}
+
+	static void multiply(mutable_columns<T> const& l, const_columns<T> const& r,
+	                     std::size_t first = 0) {
+		for(auto i = first; i < l.size; ++i) {
+			auto x = get(l, i);
+			set(l, i, x *= get(r, i));
+		}
+	}
+
+	static void divide(mutable_columns<T> const& l, const_columns<T> const& r,
+	                   std::size_t first = 0) {
+		for(auto i = first; i < l.size; ++i) {
+			auto x = get(l, i);
+			set(l, i, x /= get(r, i));
+		}
+	}
+
+	static void intersect(mutable_columns<T> const& l, const_columns<T> const& r,
+	                      std::size_t first = 0) {
+		for(auto i = first; i < l.size; ++i) {
+			set(l, i, intersection(get(l, i), get(r, i)));
+		}
+	}
+
+	static void unite(mutable_columns<T> const& l, const_columns<T> const& r,
+	                  std::size_t first = 0) {
+		for(auto i = first; i < l.size; ++i) {
+			set(l, i, hull(get(l, i), get(r, i)));
+		}
+	}
+
+	static void contains(const_columns<T> const& r, T const* values, bool* out,
+	                     std::size_t first = 0) {
+		for(auto i = first; i < r.size; ++i) {
+			out[i] = ez::contains(get(r, i), values[i]);
+		}
+	}
+
+	static bool any_contains_zero(const_columns<T> const& r, std::size_t first = 0) {
+		auto const zero = T{0};
+		auto found = false;
+		for(auto i = first; i < r.size; ++i) {
+			found |= r.lower[i] <= zero && r.upper[i] >= zero;
+		}
+		return found;
+	}
+};
+
+template <typename T>
+struct array_kernels : scalar_array_kernels<T> {
+};
+
+#ifdef EZ_SIMD
+
+// read_bits returns the Width bits of the openness of the intervals starting from i, which is a
+// multiple of Width
+template <std::size_t Width>
+unsigned read_bits(std::uint8_t const* bits, std::size_t i) noexcept {
+	auto value = 0u;
+	for(std::size_t j = 0; j < (Width + 7) / 8; ++j) {
+		value |= static_cast<unsigned>(bits[i / 8 + j]) << (8 * j);
+	}
+	return (value >> (i % 8)) & ((1u << Width) - 1);
+}
+
+template <std::size_t Width>
+void write_bits(std::uint8_t* bits, std::size_t i, unsigned value) noexcept {
+	if(Width < 8) {
+		auto const shift = i % 8;
+		auto const mask = ((1u << Width) - 1) << shift;
+		bits[i / 8] = static_cast<std::uint8_t>((bits[i / 8] & ~mask) | (value << shift));
+	} else {
+		for(std::size_t j = 0; j < Width / 8; ++j) {
+			bits[i / 8 + j] = static_cast<std::uint8_t>(value >> (8 * j));
+		}
+	}
+}
+
+// simd_block holds Simd::width intervals loaded from array_columns
+template <typename Simd>
+struct simd_block {
+	typedef typename Simd::vec vec;
+	typedef typename Simd::mask mask;
+
+	template <typename Columns>
+	simd_block(Columns const& c, std::size_t i)
+	: lower{Simd::load(c.lower + i)}
+	, upper{Simd::load(c.upper + i)}
+	, left_open{Simd::from_bits(read_bits<Simd::width>(c.left_open, i))}
+	, right_open{Simd::from_bits(read_bits<Simd::width>(c.right_open, i))} {
+	}
+
+	simd_block(vec lower, vec upper, mask left_open, mask right_open)
+	: lower{lower}
+	, upper{upper}
+	, left_open{left_open}
+	, right_open{right_open} {
+	}
+
+	void store(mutable_columns<typename Simd::type> const& c, std::size_t i) const {
+		Simd::store(c.lower + i, lower);
+		Simd::store(c.upper + i, upper);
+		write_bits<Simd::width>(c.left_open, i, Simd::to_bits(left_open));
+		write_bits<Simd::width>(c.right_open, i, Simd::to_bits(right_open));
+	}
+
+	// Returns the lanes that do not hold a valid interval, see detail::valid
+	mask invalid() const {
+		auto const open = mask_or(left_open, right_open);
+		auto const ok = mask_or(mask_and(open, Simd::lt(lower, upper)),
+		                        mask_andnot(Simd::le(lower, upper), open));
+		return Simd::from_bits(~Simd::to_bits(ok) & ((1u << Simd::width) - 1));
+	}
+
+	vec lower;
+	vec upper;
+	mask left_open;
+	mask right_open;
+};
+
+// simd_array_kernels has the same interface as scalar_array_kernels, but processes Simd::width
+// intervals at a time. Every selection below follows the order of comparisons made by the
+// operators of interval<T> so that ties, signed zeros and NaNs give the same result.
+template <typename Simd>
+struct simd_array_kernels {
+	typedef typename Simd::type T;
+	typedef typename Simd::vec vec;
+	typedef typename Simd::mask mask;
+	typedef simd_block<Simd> block;
+	typedef scalar_array_kernels<T> scalar;
+	static std::size_t const width = Simd::width;
+
+	static void add(mutable_columns<T> const& l, const_columns<T> const& r) {
+		apply(l, r, &scalar::add, [](block const& a, block const& b) -> block {
+			return block{Simd::add(a.lower, b.lower), Simd::add(a.upper, b.upper),
+			             mask_or(a.left_open, b.left_open), mask_or(a.right_open, b.right_open)};
+		});
+	}
+
+	static void subtract(mutable_columns<T> const& l, const_columns<T> const& r) {
+		apply(l, r, &scalar::subtract, [](block const& a, block const& b) -> block {
+			return block{Simd::sub(a.lower, b.upper), Simd::sub(a.upper, b.lower),
+			             mask_or(a.left_open, b.right_open), mask_or(a.right_open, b.left_open)};
+		});
+	}
+
+	static void multiply(mutable_columns<T> const& l, const_columns<T> const& r) {
+		apply(l, r, &scalar::multiply, [](block const& a, block const& b) -> block {
+			auto const z = Simd::zero();
+			auto const product = [z](vec x, mask xo, vec y, mask yo) -> candidate {
+				auto const open = mask_or(mask_or(mask_and(xo, yo), mask_and(xo, Simd::ne(y, z))),
+				                          mask_and(yo, Simd::ne(x, z)));
+				return {Simd::mul(x, y), open};
+			};
+			return select_bounds(product(a.lower, a.left_open, b.lower, b.left_open),
+			                     product(a.lower, a.left_open, b.upper, b.right_open),
+			                     product(a.upper, a.right_open, b.lower, b.left_open),
+			                     product(a.upper, a.right_open, b.upper, b.right_open));
+		});
+	}
+
+	static void divide(mutable_columns<T> const& l, const_columns<T> const& r) {
+		apply(l, r, &scalar::divide, [](block const& a, block const& b) -> block {
+			auto const z = Simd::zero();
+			auto const quotient = [z](vec x, mask xo, vec y, mask yo) -> candidate {
+				return {Simd::div(x, y), mask_and(Simd::ne(x, z), mask_or(xo, yo))};
+			};
+			return select_bounds(quotient(a.lower, a.left_open, b.lower, b.left_open),
+			                     quotient(a.lower, a.left_open, b.upper, b.right_open),
+			                     quotient(a.upper, a.right_open, b.lower, b.left_open),
+			                     quotient(a.upper, a.right_open, b.upper, b.right_open));
+		});
+	}
+
+	static void intersect(mutable_columns<T> const& l, const_columns<T> const& r) {
+		apply(l, r, &scalar::intersect, [](block const& a, block const& b) -> block {
+			// lower is std::max of (lower, left_open) pairs, which takes b if a < b
+			auto const take_lower = mask_or(Simd::lt(a.lower, b.lower),
+			                                mask_andnot(mask_andnot(b.left_open, a.left_open),
+			                                            Simd::lt(b.lower, a.lower)));
+			// upper is std::min using lt_first_gt_second, which takes b if b comes first
+			auto const take_upper = mask_or(Simd::lt(b.upper, a.upper),
+			                                mask_andnot(mask_and(Simd::eq(b.upper, a.upper),
+			                                                     b.right_open), a.right_open));
+			return block{Simd::select(take_lower, b.lower, a.lower),
+			             Simd::select(take_upper, b.upper, a.upper),
+			             mask_select(take_lower, b.left_open, a.left_open),
+			             mask_select(take_upper, b.right_open, a.right_open)};
+		});
+	}
+
+	static void unite(mutable_columns<T> const& l, const_columns<T> const& r) {
+		apply(l, r, &scalar::unite, [](block const& a, block const& b) -> block {
+			// lower is std::min of (lower, left_open) pairs, which takes b if b < a
+			auto const take_lower = mask_or(Simd::lt(b.lower, a.lower),
+			                                mask_andnot(mask_andnot(a.left_open, b.left_open),
+			                                            Simd::lt(a.lower, b.lower)));
+			// upper is std::max using lt_first_gt_second, which takes b if a comes first
+			auto const take_upper = mask_or(Simd::lt(a.upper, b.upper),
+			                                mask_andnot(mask_and(Simd::eq(a.upper, b.upper),
+			                                                     a.right_open), b.right_open));
+			return block{Simd::select(take_lower, b.lower, a.lower),
+			             Simd::select(take_upper, b.upper, a.upper),
+			             mask_select(take_lower, b.left_open, a.left_open),
+			             mask_select(take_upper, b.right_open, a.right_open)};
+		});
+	}
+
+	static void contains(const_columns<T> const& r, T const* values, bool* out) {
+		auto const blocks = r.size - r.size % width;
+		for(std::size_t i = 0; i < blocks; i += width) {
+			block const b{r, i};
+			auto const v = Simd::load(values + i);
+			auto const above = mask_or(mask_and(b.left_open, Simd::lt(b.lower, v)),
+			                           mask_andnot(Simd::le(b.lower, v), b.left_open));
+			auto const below = mask_or(mask_and(b.right_open, Simd::lt(v, b.upper)),
+			                           mask_andnot(Simd::le(v, b.upper), b.right_open));
+			auto const bits = Simd::to_bits(mask_and(above, below));
+			for(std::size_t j = 0; j < width; ++j) {
+				out[i + j] = (bits >> j) & 1u;
+			}
+		}
+		scalar::contains(r, values, out, blocks);
+	}
+
+	static bool any_contains_zero(const_columns<T> const& r) {
+		auto const blocks = r.size - r.size % width;
+		auto const z = Simd::zero();
+		auto found = 0u;
+		for(std::size_t i = 0; i < blocks; i += width) {
+			found |= Simd::to_bits(mask_and(Simd::le(Simd::load(r.lower + i), z),
+			                                Simd::le(z, Simd::load(r.upper + i))));
+		}
+		return found != 0 || scalar::any_contains_zero(r, blocks);
+	}
+
+private:
+	// candidate is a possible bound of the result of operator*= or operator/=
+	struct candidate {
+		vec value;
+		mask open;
+	};
+
+	// Chooses the lower and upper bounds from four candidates in the same way as operator*= and
+	// operator/= of interval<T>, which prefer a closed bound when two candidates are equal
+	static block select_bounds(candidate const& c0, candidate const& c1, candidate const& c2,
+	                           candidate const& c3) {
+		auto lower = c0;
+		auto upper = c0;
+		for(auto const& c : {c1, c2, c3}) {
+			auto const take_lower = mask_or(Simd::lt(c.value, lower.value),
+			                                mask_andnot(mask_andnot(lower.open, c.open),
+			                                            Simd::lt(lower.value, c.value)));
+			lower = {Simd::select(take_lower, c.value, lower.value),
+			         mask_select(take_lower, c.open, lower.open)};
+
+			auto const take_upper = mask_or(Simd::lt(upper.value, c.value),
+			                                mask_andnot(mask_and(Simd::eq(c.value, upper.value),
+			                                                     upper.open), c.open));
+			upper = {Simd::select(take_upper, c.value, upper.value),
+			         mask_select(take_upper, c.open, upper.open)};
+		}
+		return {lower.value, upper.value, lower.open, upper.open};
+	}
+
+	template <typename Function>
+	static void apply(mutable_columns<T> const& l, const_columns<T> const& r,
+	                  void (*tail)(mutable_columns<T> const&, const_columns<T> const&, std::size_t),
+	                  Function f) {
+		auto const blocks = l.size - l.size % width;
+		auto invalid = 0u;
+		for(std::size_t i = 0; i < blocks; i += width) {
+			auto const result = f(block{l, i}, block{r, i});
+			result.store(l, i);
+			invalid |= Simd::to_bits(result.invalid());
+		}
+		tail(l, r, blocks);
+		if(invalid != 0) {
+			EZ_THROW(empty_interval{});
+		}
+	}
+};
+
+template <>
+struct array_kernels<double> : simd_array_kernels<simd<double>> {
+};
+
+template <>
+struct array_kernels<float> : simd_array_kernels<simd<float>> {
+};
+
+#endif
+
+template <typename T>
+void check_sizes(interval_array<T> const& l, interval_array<T> const& r) {
+	if(l.size() != r.size()) {
+		EZ_THROW(size_mismatch{});
+	}
+}
+
+}
+
+/** A container of interval<T> that stores the lower bounds, the upper bounds and the openness of
+ *  its intervals in separate arrays, with the openness packed into one bit per bound.
+ *
+ *  The arithmetic operators, ez::intersection, ez::hull and ez::contains work on whole arrays at a
+ *  time, element by element, and give identical results to the same operators applied to each
+ *  interval<T>. For float and double they use AVX2 or AVX-512 when the compiler targets them.
+ *
+ *  \code
+ *  ez::interval_array<double> a = {ez::make_interval[0.0](1.0), ez::make_interval(-1.0)[2.0]};
+ *  ez::interval_array<double> b = {ez::make_interval[2.0][3.0], ez::make_interval[1.0][1.0]};
+ *  a *= b; // {[0, 3), (-1, 2]}
+ *  \endcode */
+template <typename T>
+class interval_array {
+public:
+	typedef T type;
+	typedef interval<T> value_type;
+	typedef std::size_t size_type;
+
+	interval_array() = default;
+
+	interval_array(size_type n, interval<T> const& value)
+	: m_lower(n, value.lower())
+	, m_upper(n, value.upper())
+	, m_left_open(bytes(n), value.left_open() ? 0xFF : 0)
+	, m_right_open(bytes(n), value.right_open() ? 0xFF : 0) {
+		clear_unused_bits();
+	}
+
+	template <typename InputIterator>
+	interval_array(InputIterator first, InputIterator last) {
+		for(; first != last; ++first) {
+			push_back(*first);
+		}
+	}
+
+	interval_array(std::initializer_list<interval<T>> list)
+	: interval_array(list.begin(), list.end()) {
+	}
+
+	size_type size() const noexcept {
+		return m_lower.size();
+	}
+
+	bool empty() const noexcept {
+		return m_lower.empty();
+	}
+
+	void reserve(size_type n) {
+		m_lower.reserve(n);
+		m_upper.reserve(n);
+		m_left_open.reserve(bytes(n));
+		m_right_open.reserve(bytes(n));
+	}
+
+	void clear() noexcept {
+		m_lower.clear();
+		m_upper.clear();
+		m_left_open.clear();
+		m_right_open.clear();
+	}
+
+	void push_back(interval<T> const& r) {
+		if(size() % 8 == 0) {
+			m_left_open.push_back(0);
+			m_right_open.push_back(0);
+		}
+
+		m_lower.push_back(r.lower());
+		m_upper.push_back(r.upper());
+		set(size() - 1, r);
+	}
+
+	/** Returns the interval at index \a i by value. */
+	interval<T> operator[](size_type i) const {
+		return detail::get(detail::array_access::columns(*this), i);
+	}
+
+	/** Replaces the interval at index \a i with \a r. */
+	void set(size_type i, interval<T> const& r) {
+		detail::set(detail::array_access::columns(*this), i, r);
+	}
+
+	/** Returns a pointer to the size() lower bounds. */
+	T const* lower_data() const noexcept {
+		return m_lower.data();
+	}
+
+	/** Returns a pointer to the size() upper bounds. */
+	T const* upper_data() const noexcept {
+		return m_upper.data();
+	}
+
+private:
+	friend struct detail::array_access;
+
+	static size_type bytes(size_type n) noexcept {
+		return (n + 7) / 8;
+	}
+
+	void clear_unused_bits() noexcept {
+		if(size() % 8 != 0) {
+			auto const mask = static_cast<std::uint8_t>((1u << (size() % 8)) - 1);
+			m_left_open.back() &= mask;
+			m_right_open.back() &= mask;
+		}
+	}
+
+	std::vector<T> m_lower;
+	std::vector<T> m_upper;
+	std::vector<std::uint8_t> m_left_open;
+	std::vector<std::uint8_t> m_right_open;
+};
+
+template <typename T>
+bool operator==(interval_array<T> const& lhs, interval_array<T> const& rhs) {
+	if(lhs.size() != rhs.size()) {
+		return false;
+	}
+
+	for(std::size_t i = 0; i < lhs.size(); ++i) {
+		if(lhs[i] != rhs[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename T>
+bool operator!=(interval_array<T> const& lhs, interval_array<T> const& rhs) {
+	return !(lhs == rhs);
+}
+
+/***************************************************************************************************
+* Element-wise operators for interval_array                                                        *
+***************************************************************************************************/
+
+// All of these throw size_mismatch if the arrays have different sizes. If any of the results is
+// empty then empty_interval is thrown and the contents of the left hand array are unspecified. If
+// any divisor contains zero then divide_by_zero is thrown before any element is changed.
+
+template <typename T>
+interval_array<T>& operator+=(interval_array<T>& l, interval_array<T> const& r) {
+	detail::check_sizes(l, r);
+	detail::array_kernels<T>::add(detail::array_access::columns(l),
+	                              detail::array_access::columns(r));
+	return l;
+}
+
+template <typename T>
+interval_array<T>& operator-=(interval_array<T>& l, interval_array<T> const& r) {
+	detail::check_sizes(l, r);
+	detail::array_kernels<T>::subtract(detail::array_access::columns(l),
+	                                   detail::array_access::columns(r));
+	return l;
+}
+
+template <typename T>
+interval_array<T>& operator*=(interval_array<T>& l, interval_array<T> const& r) {
+	detail::check_sizes(l, r);
+	detail::array_kernels<T>::multiply(detail::array_access::columns(l),
+	                                   detail::array_access::columns(r));
+	return l;
+}
+
+template <typename T>
+interval_array<T>& operator/=(interval_array<T>& l, interval_array<T> const& r) {
+	detail::check_sizes(l, r);
+	if(detail::array_kernels<T>::any_contains_zero(detail::array_access::columns(r))) {
+		EZ_THROW(divide_by_zero{});
+	}
+
+	detail::array_kernels<T>::divide(detail::array_access::columns(l),
+	                                 detail::array_access::columns(r));
+	return l;
+}
+
+template <typename T>
+interval_array<T> operator+(interval_array<T> l, interval_array<T> const& r) {
+	return l += r;
+}
+
+template <typename T>
+interval_array<T> operator-(interval_array<T> l, interval_array<T> const& r) {
+	return l -= r;
+}
+
+template <typename T>
+interval_array<T> operator*(interval_array<T> l, interval_array<T> const& r) {
+	return l *= r;
+}
+
+template <typename T>
+interval_array<T> operator/(interval_array<T> l, interval_array<T> const& r) {
+	return l /= r;
+}
+
+/** Returns the intersection of each pair of intervals in \a lhs and \a rhs. Throws empty_interval
+ *  if any pair does not intersect. */
+template <typename T>
+interval_array<T> intersection(interval_array<T> lhs, interval_array<T> const& rhs) {
+	detail::check_sizes(lhs, rhs);
+	detail::array_kernels<T>::intersect(detail::array_access::columns(lhs),
+	                                    detail::array_access::columns(rhs));
+	return lhs;
+}
+
+/** Returns the hull of each pair of intervals in \a lhs and \a rhs. */
+template <typename T>
+interval_array<T> hull(interval_array<T> lhs, interval_array<T> const& rhs) {
+	detail::check_sizes(lhs, rhs);
+	detail::array_kernels<T>::unite(detail::array_access::columns(lhs),
+	                                detail::array_access::columns(rhs));
+	return lhs;
+}
+
+/** Sets \a out[i] to whether the i-th interval of \a r contains \a values[i], for each of the
+ *  r.size() intervals. */
+template <typename T>
+void contains(interval_array<T> const& r, T const* values, bool* out) {
+	detail::array_kernels<T>::contains(detail::array_access::columns(r), values, out);
+}
+
+}
+
+#endif
@@ -0,0 +1,442 @@
+/******************************************************************//**
+ * \file   interval_file.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_23923B2D_B11D_49B2_859B_E199384BABA0
+#define INCLUDE_GUARD_23923B2D_B11D_49B2_859B_E199384BABA0
+
+#include "ez/interval.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+// Files are mapped with mmap on POSIX systems. Elsewhere they are read into memory instead, which
+// gives the same results but is not zero-copy.
+#if defined(__unix__) || defined(__APPLE__)
+#define EZ_INTERVAL_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+namespace ez {
+
+/** An invalid_interval_file exception is thrown when reading data that is not an interval file, or
+ *  that holds intervals of a different type. */
+struct invalid_interval_file : std::runtime_error {
+	invalid_interval_file()
+	: std::runtime_error{"Invalid interval file"} {
+	}
+};
+
+namespace detail {
+
+/* An interval file is a 64 byte header followed by the records, with every number little-endian.
+
+   offset  size  field
+        0     8  "EZINTRVL"
+        8     4  version, currently 1
+       12     1  the type of the bounds, from scalar_code
+       13     1  sizeof the type of the bounds
+       14     1  1 if each record has its own openness, 0 if every record has the openness below
+       15     1  the ez::openness of every record, or 0
+       16     8  the number of records
+       24     8  the size of each record in bytes
+       32    32  zero
+
+   A record is the lower bound, then the upper bound, and if records have their own openness a
+   third bound-sized slot whose first byte is the ez::openness and the rest zero. As the header is
+   64 bytes and each record is a multiple of the size of a bound, every bound is aligned when the
+   file is mapped. */
+struct file_format {
+	static std::size_t const header_size = 64;
+	static std::uint32_t const version = 1;
+
+	static char const* magic() noexcept {
+		return "EZINTRVL";
+	}
+};
+
+// scalar_code identifies the type of the bounds in the header, or is 0 for unsupported types
+template <typename T>
+struct scalar_code : std::integral_constant<unsigned,
+	std::is_same<T, bool>::value ? 0 :
+	std::is_floating_point<T>::value ? (sizeof(T) == 4 ? 9 : sizeof(T) == 8 ? 10 : 0) :
+	std::is_integral<T>::value
+	  ? (std::is_signed<T>::value ? 1 : 5) +
+	    (sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : sizeof(T) == 8 ? 3 : 0)
+	  : 0> {
+};
+
+inline bool little_endian() noexcept {
+	std::uint16_t const one = 1;
+	unsigned char first;
+	std::memcpy(&first, &one, 1);
+	return first == 1;
+}
+
+// store and load copy T to and from little-endian bytes, and only reorder the bytes on big-endian
+// systems
+template <typename T>
+void store(unsigned char* bytes, T value) noexcept {
+	std::memcpy(bytes, &value, sizeof(T));
+	if(!little_endian()) {
+		std::reverse(bytes, bytes + sizeof(T));
+	}
+}
+
+template <typename T>
+T load(unsigned char const* bytes) noexcept {
+	T value;
+	if(little_endian()) {
+		std::memcpy(&value, bytes, sizeof(T));
+	} else {
+		unsigned char reversed[sizeof(T)];
+		std::reverse_copy(bytes, bytes + sizeof(T), reversed);
+		std::memcpy(&value, reversed, sizeof(T));
+	}
+	return value;
+}
+
+// record_format describes how each type of interval is written to and read from a record
+template <typename Interval>
+struct record_format;
+
+template <typename T>
+struct record_format<interval<T>> {
+	typedef T type;
+	static bool const per_record = true;
+	static std::size_t const size = 3 * sizeof(T);
+
+	static openness fixed() noexcept {
+		return closed;
+	}
+
+	static bool accepts(bool, openness) noexcept {
+		return true;
+	}
+
+	static void write(unsigned char* bytes, interval<T> const& r) noexcept {
+		store(bytes, r.lower());
+		store(bytes + sizeof(T), r.upper());
+		std::fill(bytes + 2 * sizeof(T), bytes + size, 0);
+		bytes[2 * sizeof(T)] = static_cast<unsigned char>(r.left_open() * ez::left_open +
+		                                                  r.right_open() * ez::right_open);
+	}
+
+	static interval<T> read(unsigned char const* bytes, bool per_record, openness o) noexcept {
+		unsigned const bits = per_record ? bytes[2 * sizeof(T)] : static_cast<unsigned>(o);
+		return {load<T>(bytes), load<T>(bytes + sizeof(T)), (bits & ez::left_open) != 0,
+		        (bits & ez::right_open) != 0, ez::unchecked};
+	}
+};
+
+template <typename T, bool LOpen, bool ROpen>
+struct record_format<basic_interval<T, LOpen, ROpen>> {
+	typedef T type;
+	static bool const per_record = false;
+	static std::size_t const size = 2 * sizeof(T);
+
+	static openness fixed() noexcept {
+		return static_cast<openness>(LOpen * ez::left_open + ROpen * ez::right_open);
+	}
+
+	static bool accepts(bool per_record, openness o) noexcept {
+		return !per_record && o == fixed();
+	}
+
+	static void write(unsigned char* bytes, basic_interval<T, LOpen, ROpen> const& r) noexcept {
+		store(bytes, r.lower());
+		store(bytes + sizeof(T), r.upper());
+	}
+
+	static basic_interval<T, LOpen, ROpen> read(unsigned char const* bytes, bool, openness)
+	  noexcept {
+		return {load<T>(bytes), load<T>(bytes + sizeof(T)), ez::unchecked};
+	}
+};
+
+}
+
+/** Writes the \a n intervals starting at \a intervals to \a out in the binary interval file
+ *  format, which can be read back without parsing by interval_view and mapped_intervals. Interval
+ *  is either interval<T> or basic_interval<T, LOpen, ROpen>, where T is an integral or
+ *  floating-point type of at most 8 bytes. The bounds are written little-endian.
+ *
+ *  Errors are reported through the state of \a out, which should be opened in binary mode.
+ *
+ *  \code
+ *  std::vector<ez::interval<double>> v = ...;
+ *  std::ofstream out{"intervals.bin", std::ios::binary};
+ *  ez::write_intervals(out, v.data(), v.size());
+ *  \endcode */
+template <typename Interval>
+void write_intervals(std::ostream& out, Interval const* intervals, std::size_t n) {
+	typedef detail::record_format<Interval> format;
+	typedef typename format::type T;
+	static_assert(detail::scalar_code<T>::value != 0,
+	              "Interval files only hold integral and floating-point types of up to 8 bytes");
+
+	unsigned char header[detail::file_format::header_size] = {};
+	std::memcpy(header, detail::file_format::magic(), 8);
+	detail::store(header + 8, detail::file_format::version);
+	header[12] = static_cast<unsigned char>(detail::scalar_code<T>::value);
+	header[13] = static_cast<unsigned char>(sizeof(T));
+	header[14] = format::per_record;
+	header[15] = format::fixed();
+	detail::store(header + 16, static_cast<std::uint64_t>(n));
+	detail::store(header + 24, static_cast<std::uint64_t>(format::size));
+	out.write(reinterpret_cast<char const*>(header), sizeof(header));
+
+	// Records are written in blocks rather than one at a time
+	std::size_t const block = 512;
+	unsigned char buffer[block * format::size];
+	for(std::size_t i = 0; i < n && out; i += block) {
+		auto const m = std::min(block, n - i);
+		for(std::size_t j = 0; j < m; ++j) {
+			format::write(buffer + j * format::size, intervals[i + j]);
+		}
+		out.write(reinterpret_cast<char const*>(buffer),
+		          static_cast<std::streamsize>(m * format::size));
+	}
+}
+
+/** A read-only view of the intervals in memory holding an interval file, such as one written by
+ *  write_intervals. The header is checked on construction and each interval is read from its
+ *  record when it is accessed, so constructing a view takes the same time however many intervals
+ *  it holds. The memory must outlive the view.
+ *
+ *  An interval_view<interval<T>> reads any file of T. An interval_view<basic_interval<T, LOpen,
+ *  ROpen>> only reads files written from basic_interval<T, LOpen, ROpen>. Otherwise
+ *  invalid_interval_file is thrown. The records themselves are not checked except with assert(),
+ *  so only read files from a trusted source. */
+template <typename Interval>
+class interval_view {
+	typedef detail::record_format<Interval> format;
+	typedef typename format::type T;
+
+public:
+	typedef Interval value_type;
+
+	interval_view() noexcept
+	: m_records{nullptr}
+	, m_size{0}
+	, m_per_record{format::per_record}
+	, m_openness{format::fixed()} {
+	}
+
+	/** Views the interval file in the \a size bytes starting at \a data. */
+	interval_view(void const* data, std::size_t size)
+	: interval_view{} {
+		auto const header = static_cast<unsigned char const*>(data);
+		if(size < detail::file_format::header_size ||
+		   std::memcmp(header, detail::file_format::magic(), 8) != 0 ||
+		   detail::load<std::uint32_t>(header + 8) != detail::file_format::version ||
+		   header[12] != detail::scalar_code<T>::value || header[13] != sizeof(T) ||
+		   header[14] > 1 || header[15] > ez::open ||
+		   !format::accepts(header[14] != 0, static_cast<openness>(header[15]))) {
+			EZ_THROW(invalid_interval_file{});
+		}
+
+		m_per_record = header[14] != 0;
+		m_openness = static_cast<openness>(header[15]);
+		auto const record_size = detail::load<std::uint64_t>(header + 24);
+		auto const count = detail::load<std::uint64_t>(header + 16);
+		if(record_size != (m_per_record ? 3 : 2) * sizeof(T) ||
+		   count > (size - detail::file_format::header_size) / record_size) {
+			EZ_THROW(invalid_interval_file{});
+		}
+
+		m_records = header + detail::file_format::header_size;
+		m_size = static_cast<std::size_t>(count);
+	}
+
+	std::size_t size() const noexcept {
+		return m_size;
+	}
+
+	bool empty() const noexcept {
+		return m_size == 0;
+	}
+
+	/** Returns the interval in the \a i-th record. */
+	Interval operator[](std::size_t i) const noexcept {
+		return format::read(m_records + i * record_size(), m_per_record, m_openness);
+	}
+
+private:
+	std::size_t record_size() const noexcept {
+		return (m_per_record ? 3 : 2) * sizeof(T);
+	}
+
+	unsigned char const* m_records;
+	std::size_t m_size;
+	bool m_per_record;
+	openness m_openness;
+};
+
+/** A file mapped read-only into memory. Empty files have a null data(). */
+class mapped_file {
+public:
+	/** Maps the file at \a path, or throws std::system_error if it cannot be opened. */
+	explicit mapped_file(std::string const& path)
+	: m_data{nullptr}
+	, m_size{0} {
+#ifdef EZ_INTERVAL_FILE_MMAP
+		auto const fd = ::open(path.c_str(), O_RDONLY);
+		if(fd == -1) {
+			EZ_THROW(std::system_error(errno, std::generic_category(), path));
+		}
+
+		struct stat status;
+		if(::fstat(fd, &status) == -1) {
+			auto const error = errno;
+			::close(fd);
+			EZ_THROW(std::system_error(error, std::generic_category(), path));
+		}
+
+		m_size = static_cast<std::size_t>(status.st_size);
+		if(m_size != 0) {
+			auto const data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(data == MAP_FAILED) {
+				auto const error = errno;
+				::close(fd);
+				EZ_THROW(std::system_error(error, std::generic_category(), path));
+			}
+			m_data = data;
+		}
+		::close(fd);
+#else
+		std::ifstream in{path, std::ios::binary};
+		if(!in) {
+			EZ_THROW(std::system_error(std::make_error_code(std::errc::no_such_file_or_directory)));
+		}
+		m_buffer.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+		m_size = m_buffer.size();
+		m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+#endif
+	}
+
+	mapped_file(mapped_file&& other) noexcept
+	: m_data{other.m_data}
+	, m_size{other.m_size}
+#ifndef EZ_INTERVAL_FILE_MMAP
+	, m_buffer{std::move(other.m_buffer)}
+#endif
+	{
+		other.m_data = nullptr;
+		other.m_size = 0;
+	}
+
+	mapped_file(mapped_file const&) = delete;
+	mapped_file& operator=(mapped_file const&) = delete;
+	mapped_file& operator=(mapped_file&&) = delete;
+
+	~mapped_file() {
+#ifdef EZ_INTERVAL_FILE_MMAP
+		if(m_data != nullptr) {
+			::munmap(m_data, m_size);
+		}
+#endif
+	}
+
+	void const* data() const noexcept {
+		return m_data;
+	}
+
+	std::size_t size() const noexcept {
+		return m_size;
+	}
+
+private:
+	void* m_data;
+	std::size_t m_size;
+#ifndef EZ_INTERVAL_FILE_MMAP
+	std::vector<char> m_buffer;
+#endif
+};
+
+/** The intervals in an interval file, which is mapped into memory rather than read so that opening
+ *  it takes the same time however large it is. Intervals are read from the pages of the file as
+ *  they are accessed.
+ *
+ *  \code
+ *  ez::mapped_intervals<ez::interval<double>> const m{"intervals.bin"};
+ *  for(std::size_t i = 0; i < m.size(); ++i) {
+ *      use(m[i]);
+ *  }
+ *  \endcode */
+template <typename Interval>
+class mapped_intervals {
+public:
+	typedef Interval value_type;
+
+	/** Maps the interval file at \a path, or throws std::system_error if it cannot be opened and
+	 *  invalid_interval_file if it does not hold intervals of type Interval. */
+	explicit mapped_intervals(std::string const& path)
+	: m_file{path}
+	, m_view{m_file.data(), m_file.size()} {
+	}
+
+	std::size_t size() const noexcept {
+		return m_view.size();
+	}
+
+	bool empty() const noexcept {
+		return m_view.empty();
+	}
+
+	Interval operator[](std::size_t i) const noexcept {
+		return m_view[i];
+	}
+
+	interval_view<Interval> const& view() const noexcept {
+		return m_view;
+	}
+
+private:
+	mapped_file m_file;
+	interval_view<Interval> m_view;
+};
+
+}
+
+#endif
@@ -0,0 +1,301 @@
+/******************************************************************//**
+ * \file   interval_map.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_45CDB9BB_FDCA_49EF_8FD6_EBD2748BDF2F
+#define INCLUDE_GUARD_45CDB9BB_FDCA_49EF_8FD6_EBD2748BDF2F
+
+#include "ez/flat_index.hpp"
+#include "ez/interval.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace ez {
+
+/** A combiner for interval_map that replaces the old value with the new one. */
+struct replace {
+	template <typename V>
+	V const& operator()(V const&, V const& value) const {
+		return value;
+	}
+};
+
+/** A combiner for interval_map that keeps the larger of the old and new values. */
+struct maximum {
+	template <typename V>
+	V const& operator()(V const& old, V const& value) const {
+		return (old < value) ? value : old;
+	}
+};
+
+/** A map from half-open intervals of keys to values, where inserting a value over an interval
+ *  combines it with the values already there.
+ *
+ *  The map is stored as a sorted vector of disjoint segments, where neighbouring segments that
+ *  touch and have equal values are joined. Inserting splits the segments at the ends of the new
+ *  interval, combines the new value into the segments inside it with \a Combine(old, value) and
+ *  fills the gaps between them with the value. Combine defaults to std::plus<V>, and ez::maximum
+ *  and ez::replace are other common choices.
+ *
+ *  Lookups go through an index in the style of a B+ tree, stored flat with one vector for each
+ *  level. Each node is 16 keys next to each other and a lookup counts the keys in one node at
+ *  each level that are not greater than the key, which is a few SIMD comparisons for double,
+ *  float, std::int32_t and std::int64_t keys when compiling for AVX2 or AVX-512. Inserting one
+ *  interval is linear in the number of segments, as the segments are moved and the index is
+ *  rebuilt. To insert many intervals, pass them all to the constructor or to insert(first, last),
+ *  which rebuilds the index once and takes O(log n) for each interval plus the number of segments
+ *  it covers.
+ *
+ *  \code
+ *  ez::interval_map<int, int> m;
+ *  m.insert(ez::make_interval[0](10), 1);
+ *  m.insert(ez::make_interval[5](15), 2);
+ *  // m = {[0, 5) -> 1, [5, 10) -> 3, [10, 15) -> 2}
+ *  assert(*m.find(7) == 3);
+ *  assert(m.find(15) == nullptr);
+ *  \endcode */
+template <typename K, typename V, typename Combine = std::plus<V>>
+class interval_map {
+public:
+	typedef K key_type;
+	typedef V mapped_type;
+	typedef std::size_t size_type;
+
+	explicit interval_map(Combine combine = Combine{})
+	: m_combine(combine) {
+	}
+
+	/** Constructs the map by inserting each std::pair<ropen_interval<K>, V> in [first, last) in
+	 *  order. */
+	template <typename InputIterator>
+	interval_map(InputIterator first, InputIterator last, Combine combine = Combine{})
+	: m_combine(combine) {
+		insert(first, last);
+	}
+
+	/** Returns the number of segments. */
+	size_type size() const {
+		return m_segments.size();
+	}
+
+	bool empty() const {
+		return m_segments.empty();
+	}
+
+	void clear() {
+		m_segments.clear();
+		m_index = detail::flat_index<K>{};
+	}
+
+	/** Returns the keys of the i-th segment in order of keys. */
+	ropen_interval<K> range(size_type i) const {
+		return {m_segments[i].lower, m_segments[i].upper, detail::unchecked_tag{}};
+	}
+
+	/** Returns the value of the i-th segment in order of keys. */
+	V const& value(size_type i) const {
+		return m_segments[i].value;
+	}
+
+	/** Combines \a value into every key of \a r. */
+	void insert(ropen_interval<K> const& r, V const& value) {
+		auto const& lower = r.lower();
+		auto const& upper = r.upper();
+
+		// [first, last) are the segments that overlap r, widened by one on each side so that
+		// neighbours can be joined with the new segments
+		auto first = static_cast<std::size_t>(
+		    std::partition_point(m_segments.begin(), m_segments.end(), [&](segment const& s) {
+			    return !(lower < s.upper);
+		    }) - m_segments.begin());
+		auto last = static_cast<std::size_t>(
+		    std::partition_point(m_segments.begin() + first, m_segments.end(),
+		                         [&](segment const& s) { return s.lower < upper; }) -
+		    m_segments.begin());
+		first -= (first > 0);
+		last += (last < m_segments.size());
+
+		std::vector<segment> pieces;
+		pieces.reserve(2 * (last - first) + 2);
+		combine_into(pieces, m_segments.begin() + first, m_segments.begin() + last, r, value);
+		m_segments.erase(m_segments.begin() + first, m_segments.begin() + last);
+		m_segments.insert(m_segments.begin() + first, pieces.begin(), pieces.end());
+		rebuild_index();
+	}
+
+	/** Inserts each std::pair<ropen_interval<K>, V> in [first, last) in order, with the same
+	 *  result as calling insert for each of them but only rebuilding the index once. The map is
+	 *  unchanged if Combine throws. */
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		// The segments are copied into a map keyed by lower bound while inserting, so that each
+		// insert only touches the segments it covers
+		std::map<K, segment> segments;
+		for(auto const& s : m_segments) {
+			segments.emplace_hint(segments.end(), s.lower, s);
+		}
+
+		std::vector<segment> pieces;
+		for(; first != last; ++first) {
+			auto const& r = first->first;
+
+			// As in insert(r, value), the segments that overlap r and one more on each side. The
+			// loop in combine_into skips any extra segments that do not touch r.
+			auto begin = segments.upper_bound(r.lower());
+			for(int i = 0; i < 2 && begin != segments.begin(); ++i) {
+				--begin;
+			}
+			auto end = segments.lower_bound(r.upper());
+			if(end != segments.end()) {
+				++end;
+			}
+
+			pieces.clear();
+			combine_into(pieces, begin, end, r, first->second);
+			end = segments.erase(begin, end);
+			for(auto& p : pieces) {
+				segments.emplace_hint(end, p.lower, std::move(p));
+			}
+		}
+
+		std::vector<segment> result;
+		result.reserve(segments.size());
+		for(auto& s : segments) {
+			result.push_back(std::move(s.second));
+		}
+		m_segments.swap(result);
+		rebuild_index();
+	}
+
+	/** Returns a pointer to the value at \a key, or nullptr if no segment contains it. */
+	V const* find(K const& key) const {
+		// The last segment whose lower bound is at most key
+		auto const count = m_index.count_not_greater(key);
+		if(count == 0 || !(key < m_segments[count - 1].upper)) {
+			return nullptr;
+		}
+		return &m_segments[count - 1].value;
+	}
+
+	bool contains(K const& key) const {
+		return find(key) != nullptr;
+	}
+
+private:
+	struct segment {
+		K lower;
+		K upper;
+		V value;
+	};
+
+	// Appends [lower, upper) -> value to pieces, joining it with the last piece if they touch and
+	// have the same value
+	static void push(std::vector<segment>& pieces, K const& lower, K const& upper,
+	                 V const& value) {
+		if(!pieces.empty() && !(pieces.back().upper < lower) && pieces.back().value == value) {
+			pieces.back().upper = upper;
+		} else {
+			pieces.push_back(segment{lower, upper, value});
+		}
+	}
+
+	static void fill_gap(std::vector<segment>& pieces, K const& lower, K const& upper,
+	                     V const& value) {
+		if(lower < upper) {
+			push(pieces, lower, upper, value);
+		}
+	}
+
+	static segment const& as_segment(segment const& s) {
+		return s;
+	}
+
+	static segment const& as_segment(std::pair<K const, segment> const& s) {
+		return s.second;
+	}
+
+	// Appends to pieces the segments in [first, last) with value combined into the keys of r,
+	// which must include every segment that overlaps r and one more on each side if there is one
+	template <typename Iterator>
+	void combine_into(std::vector<segment>& pieces, Iterator first, Iterator last,
+	                  ropen_interval<K> const& r, V const& value) {
+		auto const& lower = r.lower();
+		auto const& upper = r.upper();
+		auto cursor = lower;
+		auto inserted = false;
+		for(; first != last; ++first) {
+			auto const& s = as_segment(*first);
+			if(!(lower < s.upper) || !(s.lower < upper)) {
+				// A neighbour outside of r, which fills the last gap in r if it is after r
+				if(!inserted && lower < s.upper) {
+					fill_gap(pieces, cursor, upper, value);
+					inserted = true;
+				}
+				push(pieces, s.lower, s.upper, s.value);
+				continue;
+			}
+
+			if(s.lower < lower) {
+				push(pieces, s.lower, lower, s.value);
+			} else {
+				fill_gap(pieces, cursor, s.lower, value);
+			}
+			push(pieces, std::max(s.lower, lower), std::min(s.upper, upper),
+			     m_combine(s.value, value));
+			if(upper < s.upper) {
+				push(pieces, upper, s.upper, s.value);
+			}
+			cursor = s.upper;
+		}
+		if(!inserted) {
+			fill_gap(pieces, cursor, upper, value);
+		}
+	}
+
+	void rebuild_index() {
+		std::vector<K> lowers;
+		lowers.reserve(m_segments.size());
+		for(auto const& s : m_segments) {
+			lowers.push_back(s.lower);
+		}
+		m_index = detail::flat_index<K>(lowers.begin(), lowers.end());
+	}
+
+	std::vector<segment> m_segments;
+	detail::flat_index<K> m_index;
+	Combine m_combine;
+};
+
+}
+
+#endif
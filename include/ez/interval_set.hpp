@@ -0,0 +1,343 @@
+/******************************************************************//**
+ * \file   interval_set.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_7A511E42_53EA_4034_81EE_F0B9E5DBA3C9
+#define INCLUDE_GUARD_7A511E42_53EA_4034_81EE_F0B9E5DBA3C9
+
+#include "ez/interval.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace ez {
+
+namespace detail {
+
+// A cut is a position between values, either just before value or just after it. A lower bound
+// [a is the cut before a and (a is the cut after a, while an upper bound b) is the cut before b and
+// b] is the cut after b. Comparing cuts orders equal lower bounds closed before open, and equal
+// upper bounds open before closed, which are the same rules as std::min with pairs and
+// lt_first_gt_second. Every interval is then the half-open range of cuts [lower, upper).
+template <typename T>
+struct cut {
+	T value;
+	bool after;
+};
+
+template <typename T>
+bool operator<(cut<T> const& lhs, cut<T> const& rhs) {
+	return (lhs.value == rhs.value) ? lhs.after < rhs.after : lhs.value < rhs.value;
+}
+
+template <typename T>
+bool operator==(cut<T> const& lhs, cut<T> const& rhs) {
+	return lhs.value == rhs.value && lhs.after == rhs.after;
+}
+
+template <typename T>
+bool operator<=(cut<T> const& lhs, cut<T> const& rhs) {
+	return !(rhs < lhs);
+}
+
+template <typename T>
+cut<T> lower_cut(interval<T> const& r) {
+	return {r.lower(), r.left_open()};
+}
+
+template <typename T>
+cut<T> upper_cut(interval<T> const& r) {
+	return {r.upper(), r.right_closed()};
+}
+
+// Returns the interval between two cuts, where lower < upper
+template <typename T>
+interval<T> between(cut<T> const& lower, cut<T> const& upper) {
+	return {lower.value, upper.value, lower.after, !upper.after, unchecked_tag{}};
+}
+
+// Returns the i-th cut of intervals, which is the lower cut of intervals[i / 2] when i is even
+// and the upper cut otherwise
+template <typename T>
+cut<T> nth_cut(std::vector<interval<T>> const& intervals, std::size_t i) {
+	return (i % 2 == 0) ? lower_cut(intervals[i / 2]) : upper_cut(intervals[i / 2]);
+}
+
+}
+
+/** A set of values stored as a sorted vector of disjoint intervals.
+ *
+ *  Intervals that overlap or touch are merged, so [0, 1) and [1, 2] are stored as [0, 2], but
+ *  [0, 1) and (1, 2] are kept apart as 1 is in neither. The values are treated as continuous, so
+ *  [0, 1] and [2, 3] of int are not merged either.
+ *
+ *  The set operators |, &, - and ^ run in linear time in the total number of intervals.
+ *
+ *  \code
+ *  ez::interval_set<int> s = {ez::make_interval[5](8), ez::make_interval[0](2)};
+ *  s.insert(ez::make_interval[2][5]); // {[0, 8)}
+ *  s.erase(ez::make_interval(3)(4));  // {[0, 3], [4, 8)}
+ *  \endcode */
+template <typename T>
+class interval_set {
+public:
+	typedef T type;
+	typedef interval<T> value_type;
+	typedef typename std::vector<interval<T>>::const_iterator iterator;
+	typedef iterator const_iterator;
+	typedef std::size_t size_type;
+
+	interval_set() = default;
+
+	/** Builds the set from intervals in any order in O(n log n). */
+	template <typename InputIterator>
+	interval_set(InputIterator first, InputIterator last)
+	: m_intervals(first, last) {
+		std::sort(m_intervals.begin(), m_intervals.end(),
+		          [](interval<T> const& a, interval<T> const& b) {
+			return detail::lower_cut(a) < detail::lower_cut(b);
+		});
+
+		// Merge neighbours that overlap or touch in place
+		auto out = m_intervals.begin();
+		for(auto it = m_intervals.begin(); it != m_intervals.end(); ++it) {
+			if(out != m_intervals.begin() &&
+			   detail::lower_cut(*it) <= detail::upper_cut(*std::prev(out))) {
+				auto& last = *std::prev(out);
+				if(detail::upper_cut(last) < detail::upper_cut(*it)) {
+					last = detail::between(detail::lower_cut(last), detail::upper_cut(*it));
+				}
+			} else {
+				*out++ = *it;
+			}
+		}
+		m_intervals.erase(out, m_intervals.end());
+	}
+
+	interval_set(std::initializer_list<interval<T>> list)
+	: interval_set(list.begin(), list.end()) {
+	}
+
+	/** Adds all values of \a r to the set, merging it with any intervals that it overlaps or
+	 *  touches. */
+	void insert(interval<T> const& r) {
+		auto const lower = detail::lower_cut(r);
+		auto const upper = detail::upper_cut(r);
+
+		// [first, last) are the intervals that overlap or touch r
+		auto const first = std::lower_bound(m_intervals.begin(), m_intervals.end(), lower,
+		                                    [](interval<T> const& x, detail::cut<T> const& c) {
+			return detail::upper_cut(x) < c;
+		});
+		auto const last = std::upper_bound(first, m_intervals.end(), upper,
+		                                   [](detail::cut<T> const& c, interval<T> const& x) {
+			return c < detail::lower_cut(x);
+		});
+
+		if(first == last) {
+			m_intervals.insert(first, r);
+			return;
+		}
+
+		*first = detail::between(std::min(lower, detail::lower_cut(*first)),
+		                         std::max(upper, detail::upper_cut(*std::prev(last))));
+		m_intervals.erase(std::next(first), last);
+	}
+
+	/** Removes all values of \a r from the set. */
+	void erase(interval<T> const& r) {
+		auto const lower = detail::lower_cut(r);
+		auto const upper = detail::upper_cut(r);
+
+		// [first, last) are the intervals that overlap r
+		auto first = std::upper_bound(m_intervals.begin(), m_intervals.end(), lower,
+		                              [](detail::cut<T> const& c, interval<T> const& x) {
+			return c < detail::upper_cut(x);
+		});
+		auto const last = std::lower_bound(first, m_intervals.end(), upper,
+		                                   [](interval<T> const& x, detail::cut<T> const& c) {
+			return detail::lower_cut(x) < c;
+		});
+
+		if(first == last) {
+			return;
+		}
+
+		// Keep the parts of the first and last intervals that stick out of r
+		auto const first_lower = detail::lower_cut(*first);
+		auto const last_upper = detail::upper_cut(*std::prev(last));
+		first = m_intervals.erase(first, last);
+		if(upper < last_upper) {
+			first = m_intervals.insert(first, detail::between(upper, last_upper));
+		}
+		if(first_lower < lower) {
+			m_intervals.insert(first, detail::between(first_lower, lower));
+		}
+	}
+
+	/** Returns true if \a value is in the set, in O(log n). */
+	bool contains(T const& value) const {
+		detail::cut<T> const point{value, false};
+		auto const it = std::upper_bound(m_intervals.begin(), m_intervals.end(), point,
+		                                 [](detail::cut<T> const& c, interval<T> const& x) {
+			return c < detail::lower_cut(x);
+		});
+		return it != m_intervals.begin() && point < detail::upper_cut(*std::prev(it));
+	}
+
+	void clear() noexcept {
+		m_intervals.clear();
+	}
+
+	/** Returns the number of disjoint intervals in the set. */
+	size_type size() const noexcept {
+		return m_intervals.size();
+	}
+
+	bool empty() const noexcept {
+		return m_intervals.empty();
+	}
+
+	iterator begin() const noexcept {
+		return m_intervals.begin();
+	}
+
+	iterator end() const noexcept {
+		return m_intervals.end();
+	}
+
+	iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	iterator cend() const noexcept {
+		return end();
+	}
+
+	/** Returns the set of values where \a in(in lhs, in rhs) is true, in O(lhs.size() +
+	 *  rhs.size()). */
+	template <typename Predicate>
+	static interval_set<T> combine(interval_set<T> const& lhs, interval_set<T> const& rhs,
+	                               Predicate in) {
+		auto const& a = lhs.m_intervals;
+		auto const& b = rhs.m_intervals;
+		auto const a_cuts = 2 * a.size();
+		auto const b_cuts = 2 * b.size();
+
+		interval_set<T> result;
+		std::size_t i = 0;
+		std::size_t j = 0;
+		auto inside = false;
+		detail::cut<T> start{};
+		while(i < a_cuts || j < b_cuts) {
+			// Move past the next cut in either set, or both if they are equal, which joins
+			// intervals that touch
+			auto const take_a = j == b_cuts ||
+			                    (i < a_cuts && detail::nth_cut(a, i) <= detail::nth_cut(b, j));
+			auto const take_b = i == a_cuts ||
+			                    (j < b_cuts && detail::nth_cut(b, j) <= detail::nth_cut(a, i));
+			auto const c = take_a ? detail::nth_cut(a, i) : detail::nth_cut(b, j);
+			i += take_a;
+			j += take_b;
+
+			// After moving past an odd number of cuts we are inside that set
+			auto const now = static_cast<bool>(in(i % 2 == 1, j % 2 == 1));
+			if(now && !inside) {
+				start = c;
+			} else if(!now && inside) {
+				result.m_intervals.push_back(detail::between(start, c));
+			}
+			inside = now;
+		}
+		return result;
+	}
+
+private:
+	std::vector<interval<T>> m_intervals;
+};
+
+template <typename T>
+bool operator==(interval_set<T> const& lhs, interval_set<T> const& rhs) {
+	return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T>
+bool operator!=(interval_set<T> const& lhs, interval_set<T> const& rhs) {
+	return !(lhs == rhs);
+}
+
+/** Returns the union of \a lhs and \a rhs. */
+template <typename T>
+interval_set<T> operator|(interval_set<T> const& lhs, interval_set<T> const& rhs) {
+	return interval_set<T>::combine(lhs, rhs, [](bool a, bool b){ return a || b; });
+}
+
+/** Returns the intersection of \a lhs and \a rhs. */
+template <typename T>
+interval_set<T> operator&(interval_set<T> const& lhs, interval_set<T> const& rhs) {
+	return interval_set<T>::combine(lhs, rhs, [](bool a, bool b){ return a && b; });
+}
+
+/** Returns the values of \a lhs that are not in \a rhs. */
+template <typename T>
+interval_set<T> operator-(interval_set<T> const& lhs, interval_set<T> const& rhs) {
+	return interval_set<T>::combine(lhs, rhs, [](bool a, bool b){ return a && !b; });
+}
+
+/** Returns the values that are in exactly one of \a lhs and \a rhs. */
+template <typename T>
+interval_set<T> operator^(interval_set<T> const& lhs, interval_set<T> const& rhs) {
+	return interval_set<T>::combine(lhs, rhs, [](bool a, bool b){ return a != b; });
+}
+
+template <typename T>
+interval_set<T>& operator|=(interval_set<T>& lhs, interval_set<T> const& rhs) {
+	return lhs = lhs | rhs;
+}
+
+template <typename T>
+interval_set<T>& operator&=(interval_set<T>& lhs, interval_set<T> const& rhs) {
+	return lhs = lhs & rhs;
+}
+
+template <typename T>
+interval_set<T>& operator-=(interval_set<T>& lhs, interval_set<T> const& rhs) {
+	return lhs = lhs - rhs;
+}
+
+template <typename T>
+interval_set<T>& operator^=(interval_set<T>& lhs, interval_set<T> const& rhs) {
+	return lhs = lhs ^ rhs;
+}
+
+}
+
+#endif
@@ -0,0 +1,299 @@
+/******************************************************************//**
+ * \file   interval_tree.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_F28D7A66_AB83_4B1D_BBDF_E03616F77268
+#define INCLUDE_GUARD_F28D7A66_AB83_4B1D_BBDF_E03616F77268
+
+#include "ez/interval.hpp"
+#include "ez/interval_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ez {
+
+/** A multimap from intervals to values that finds all intervals containing a value, or
+ *  overlapping an interval.
+ *
+ *  The intervals are kept in a treap ordered by their lower bounds, where each node also stores
+ *  the largest upper bound in its subtree, so subtrees that cannot overlap the query are skipped.
+ *  Inserting and erasing take O(log n) expected time. A query that finds k intervals takes
+ *  O(min(n, (k + 1) log n)) expected time rather than O(log n + k), which would need a structure
+ *  such as a priority search tree that is much harder to keep balanced under inserts and erases.
+ *  Nodes are stored in a pool and link to each other by index, and the values are kept in
+ *  a separate pool, so a query only touches the memory it needs. The slots of erased nodes are
+ *  reused by later inserts, and the value of an erased node is replaced by Value{} so that any
+ *  resources it holds are released straight away. Value must be default constructible.
+ *
+ *  Queries call a visitor with each interval found and its value, in order of lower bound, and
+ *  never allocate. Like the standard containers, any number of threads may query the tree at the
+ *  same time, but inserting and erasing must be synchronized with every other use. Use
+ *  concurrent_interval_tree to insert and erase from many threads.
+ *
+ *  \code
+ *  ez::interval_tree<int, std::string> tree;
+ *  tree.insert(ez::make_interval[0](10), "a");
+ *  auto const b = tree.insert(ez::make_interval(5)[20], "b");
+ *  tree.containing(7, [](ez::interval<int> const&, std::string const& s) {
+ *      std::cout << s; // prints a then b
+ *  });
+ *  tree.erase(b);
+ *  \endcode */
+template <typename T, typename Value>
+class interval_tree {
+public:
+	typedef T type;
+	typedef Value value_type;
+	typedef std::size_t size_type;
+
+	/** Identifies an interval in the tree, which stays valid until that interval is erased. */
+	typedef std::size_t handle;
+
+	interval_tree()
+	: m_root{none()}
+	, m_free{none()}
+	, m_size{0}
+	, m_seed{2463534242u} {
+	}
+
+	size_type size() const {
+		return m_size;
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	/** Reserves space for \a n intervals so that inserting them does not reallocate. */
+	void reserve(size_type n) {
+		m_nodes.reserve(n);
+		m_values.reserve(n);
+	}
+
+	void clear() {
+		m_nodes.clear();
+		m_values.clear();
+		m_root = none();
+		m_free = none();
+		m_size = 0;
+	}
+
+	/** Adds \a r with the value \a value and returns a handle to it. */
+	handle insert(interval<T> const& r, Value value) {
+		handle n;
+		if(m_free != none()) {
+			n = m_free;
+			m_free = m_nodes[n].left;
+			m_nodes[n].range = r;
+			m_values[n] = std::move(value);
+		} else {
+			n = m_nodes.size();
+			m_nodes.push_back(node{r, detail::upper_cut(r), none(), none(), 0});
+			m_values.push_back(std::move(value));
+		}
+
+		auto& x = m_nodes[n];
+		x.max_upper = detail::upper_cut(r);
+		x.left = none();
+		x.right = none();
+		x.priority = next_priority();
+
+		handle lower;
+		handle upper;
+		split(m_root, n, lower, upper);
+		m_root = merge(merge(lower, n), upper);
+		++m_size;
+		return n;
+	}
+
+	/** Removes the interval \a h, which must have been returned by insert and not yet erased. */
+	void erase(handle h) {
+		m_root = erase(m_root, h);
+		m_values[h] = Value{};
+		m_nodes[h].left = m_free;
+		m_free = h;
+		--m_size;
+	}
+
+	interval<T> const& range(handle h) const {
+		return m_nodes[h].range;
+	}
+
+	Value& value(handle h) {
+		return m_values[h];
+	}
+
+	Value const& value(handle h) const {
+		return m_values[h];
+	}
+
+	/** Calls \a f(r, value) for every interval r that contains \a x. */
+	template <typename Visitor>
+	void containing(T const& x, Visitor f) const {
+		visit(m_root, detail::cut<T>{x, false}, detail::cut<T>{x, true}, f);
+	}
+
+	/** Calls \a f(r, value) for every interval r that has at least one value in common with
+	 *  \a query. */
+	template <typename Visitor>
+	void overlapping(interval<T> const& query, Visitor f) const {
+		visit(m_root, detail::lower_cut(query), detail::upper_cut(query), f);
+	}
+
+private:
+	struct node {
+		interval<T> range;
+		detail::cut<T> max_upper;
+		handle left;
+		handle right;
+		std::uint32_t priority;
+	};
+
+	static handle none() {
+		return static_cast<handle>(-1);
+	}
+
+	// xorshift32, which never returns 0 from a non-zero seed
+	std::uint32_t next_priority() {
+		m_seed ^= m_seed << 13;
+		m_seed ^= m_seed >> 17;
+		m_seed ^= m_seed << 5;
+		return m_seed;
+	}
+
+	// Nodes are ordered by lower bound, and then by handle so that every node has a unique key
+	bool less(handle a, handle b) const {
+		auto const lhs = detail::lower_cut(m_nodes[a].range);
+		auto const rhs = detail::lower_cut(m_nodes[b].range);
+		return (lhs == rhs) ? a < b : lhs < rhs;
+	}
+
+	void update(handle n) {
+		auto& x = m_nodes[n];
+		x.max_upper = detail::upper_cut(x.range);
+		if(x.left != none() && x.max_upper < m_nodes[x.left].max_upper) {
+			x.max_upper = m_nodes[x.left].max_upper;
+		}
+		if(x.right != none() && x.max_upper < m_nodes[x.right].max_upper) {
+			x.max_upper = m_nodes[x.right].max_upper;
+		}
+	}
+
+	// Splits the tree t into the nodes ordered before key and the rest
+	void split(handle t, handle key, handle& lower, handle& upper) {
+		if(t == none()) {
+			lower = none();
+			upper = none();
+			return;
+		}
+
+		if(less(t, key)) {
+			split(m_nodes[t].right, key, m_nodes[t].right, upper);
+			lower = t;
+		} else {
+			split(m_nodes[t].left, key, lower, m_nodes[t].left);
+			upper = t;
+		}
+		update(t);
+	}
+
+	// Joins two trees where all nodes of lower are ordered before all nodes of upper
+	handle merge(handle lower, handle upper) {
+		if(lower == none()) {
+			return upper;
+		}
+		if(upper == none()) {
+			return lower;
+		}
+
+		if(m_nodes[upper].priority < m_nodes[lower].priority) {
+			auto const right = merge(m_nodes[lower].right, upper);
+			m_nodes[lower].right = right;
+			update(lower);
+			return lower;
+		} else {
+			auto const left = merge(lower, m_nodes[upper].left);
+			m_nodes[upper].left = left;
+			update(upper);
+			return upper;
+		}
+	}
+
+	// Removes key from the tree t, which must contain it, and returns the new root
+	handle erase(handle t, handle key) {
+		if(t == key) {
+			return merge(m_nodes[t].left, m_nodes[t].right);
+		}
+
+		if(less(key, t)) {
+			auto const left = erase(m_nodes[t].left, key);
+			m_nodes[t].left = left;
+		} else {
+			auto const right = erase(m_nodes[t].right, key);
+			m_nodes[t].right = right;
+		}
+		update(t);
+		return t;
+	}
+
+	// Visits every node of t whose interval overlaps the cuts [lower, upper)
+	template <typename Visitor>
+	void visit(handle t, detail::cut<T> const& lower, detail::cut<T> const& upper,
+	           Visitor& f) const {
+		while(t != none()) {
+			auto const& x = m_nodes[t];
+			if(x.max_upper <= lower) {
+				return;
+			}
+
+			visit(x.left, lower, upper, f);
+			if(upper <= detail::lower_cut(x.range)) {
+				return;
+			}
+
+			if(lower < detail::upper_cut(x.range)) {
+				f(x.range, m_values[t]);
+			}
+			t = x.right;
+		}
+	}
+
+	std::vector<node> m_nodes;
+	std::vector<Value> m_values;
+	handle m_root;
+	handle m_free;
+	size_type m_size;
+	std::uint32_t m_seed;
+};
+
+}
+
+#endif
@@ -0,0 +1,299 @@
+/******************************************************************//**
+ * \file   maybe_interval.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_7A7EEE4A_9166_4F0E_999E_47159BDCC90B
+#define INCLUDE_GUARD_7A7EEE4A_9166_4F0E_999E_47159BDCC90B
+
+#include "ez/interval.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ez {
+
+/** An interval of type T that may be empty.
+ *
+ *  A maybe_interval is empty when its bounds and openness do not describe any value, such as (3, 3)
+ *  or [4, 2], so there is no separate flag to keep up to date. The functions that take a
+ *  maybe_interval, such as intersection, contains and subset, are written so that an empty
+ *  interval gives the right result without any branches, which makes them suitable for filtering
+ *  large numbers of intervals where most results are empty.
+ *
+ *  maybe_interval does not satisfy is_interval, as functions such as midpoint and hull do not
+ *  make sense for an empty interval. Use value() to get the interval when it is not empty.
+ *
+ *  \code
+ *  ez::maybe_interval<int> window = ez::make_interval[0](10);
+ *  auto hit = intersection(window, ez::make_interval[5](20)); // [5, 10)
+ *  auto miss = intersection(window, ez::make_interval[20](30));
+ *  assert(!hit.empty() && miss.empty());
+ *  \endcode */
+template <typename T>
+class maybe_interval {
+public:
+	typedef T type;
+	typedef typename interval<T>::difference_type difference_type;
+	typedef typename interval<T>::iterator iterator;
+	typedef iterator const_iterator;
+
+	/** Constructs an empty interval. */
+	constexpr maybe_interval() noexcept(std::is_nothrow_default_constructible<T>::value)
+	: m_lower{}
+	, m_upper{}
+	, m_left_open{true}
+	, m_right_open{true} {
+	}
+
+	/** Constructs the interval with the given bounds and openness, which is empty if there are no
+	 *  values between the bounds. */
+	constexpr maybe_interval(T const& lower, T const& upper, bool left_open, bool right_open)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: m_lower{lower}
+	, m_upper{upper}
+	, m_left_open{left_open}
+	, m_right_open{right_open} {
+	}
+
+	constexpr maybe_interval(T const& lower, T const& upper, ez::openness o)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: maybe_interval{lower, upper, (o & ez::left_open) != 0, (o & ez::right_open) != 0} {
+	}
+
+	constexpr maybe_interval(interval<T> const& r)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: maybe_interval{r.lower(), r.upper(), r.left_open(), r.right_open()} {
+	}
+
+	template <bool LOpen, bool ROpen>
+	constexpr maybe_interval(basic_interval<T, LOpen, ROpen> const& r)
+	  noexcept(std::is_nothrow_copy_constructible<T>::value)
+	: maybe_interval{r.lower(), r.upper(), LOpen, ROpen} {
+	}
+
+	/** Returns true if there are no values in this interval. */
+	constexpr bool empty() const noexcept(is_nothrow_totally_ordered<T>::value) {
+		return !((m_lower < m_upper) | ((m_lower == m_upper) & !m_left_open & !m_right_open));
+	}
+
+	/** Returns the interval, or throws empty_interval if it is empty. */
+	interval<T> value() const {
+		if(empty()) {
+			EZ_THROW(empty_interval{});
+		}
+		return {m_lower, m_upper, m_left_open, m_right_open, detail::unchecked_tag{}};
+	}
+
+	/** The bounds and openness are only meaningful if the interval is not empty. */
+	constexpr T const& lower() const noexcept {
+		return m_lower;
+	}
+
+	constexpr T const& upper() const noexcept {
+		return m_upper;
+	}
+
+	constexpr bool left_open() const noexcept {
+		return m_left_open;
+	}
+
+	constexpr bool left_closed() const noexcept {
+		return !m_left_open;
+	}
+
+	constexpr bool right_open() const noexcept {
+		return m_right_open;
+	}
+
+	constexpr bool right_closed() const noexcept {
+		return !m_right_open;
+	}
+
+	/** Returns the number of elements in this interval, which is 0 if it is empty. This is only
+	 *  available if the iterator_category of direct_iterator<T> is random access. */
+	EZ_CONSTEXPR14 difference_type size() const {
+		auto const n = detail::size<difference_type>(m_lower, m_upper, m_left_open, m_right_open);
+		return empty() ? difference_type{0} : n;
+	}
+
+	/** begin() and end() are equal if the interval is empty. */
+	EZ_CONSTEXPR14 iterator begin() const {
+		return iteration::begin(m_lower, m_upper, m_left_open, m_right_open);
+	}
+
+	EZ_CONSTEXPR14 iterator end() const {
+		return empty() ? begin() : iteration::end(m_lower, m_upper, m_left_open, m_right_open);
+	}
+
+	EZ_CONSTEXPR14 iterator cbegin() const {
+		return begin();
+	}
+
+	EZ_CONSTEXPR14 iterator cend() const {
+		return end();
+	}
+
+private:
+	typedef detail::interval_iteration<T> iteration;
+
+	T m_lower;
+	T m_upper;
+	bool m_left_open;
+	bool m_right_open;
+};
+
+template <typename T>
+struct is_maybe_interval : std::false_type {
+};
+
+template <typename T>
+struct is_maybe_interval<maybe_interval<T>> : std::true_type {
+};
+
+namespace detail {
+
+// maybe_arguments is true if A and B are intervals or maybe_intervals, and at least one of them is
+// a maybe_interval
+template <typename A, typename B>
+struct maybe_arguments
+  : std::integral_constant<bool, (is_maybe_interval<A>::value || is_maybe_interval<B>::value) &&
+                                 (is_maybe_interval<A>::value || is_interval<A>::value) &&
+                                 (is_maybe_interval<B>::value || is_interval<B>::value)> {
+};
+
+}
+
+/** Returns true if \a value is within \a r, which is never the case if \a r is empty. */
+template <typename T>
+constexpr bool contains(maybe_interval<T> const& r, T const& value)
+  noexcept(is_nothrow_totally_ordered<T>::value) {
+	return ((r.lower() < value) | (r.left_closed() & (r.lower() == value))) &
+	       ((value < r.upper()) | (r.right_closed() & (value == r.upper())));
+}
+
+/** Returns true if \a lhs and \a rhs are both empty, or if they are both non-empty with the same
+ *  bounds and openness. */
+template <typename T>
+constexpr bool operator==(maybe_interval<T> const& lhs, maybe_interval<T> const& rhs)
+  noexcept(is_nothrow_totally_ordered<T>::value) {
+	return (lhs.empty() & rhs.empty()) |
+	       (!lhs.empty() & !rhs.empty() & (lhs.lower() == rhs.lower()) &
+	        (lhs.upper() == rhs.upper()) & (lhs.left_open() == rhs.left_open()) &
+	        (lhs.right_open() == rhs.right_open()));
+}
+
+template <typename T>
+constexpr bool operator!=(maybe_interval<T> const& lhs, maybe_interval<T> const& rhs)
+  noexcept(is_nothrow_totally_ordered<T>::value) {
+	return !(lhs == rhs);
+}
+
+/** Returns the intersection of \a lhs and \a rhs, which is empty if they do not overlap. At least
+ *  one of them must be a maybe_interval, and the other may be any interval.
+ *
+ *  The intersection of an empty interval with anything is empty, as its bounds only add more
+ *  constraints, so this never needs to check whether either argument is empty. */
+template <typename Interval1, typename Interval2,
+          typename std::enable_if<detail::maybe_arguments<Interval1, Interval2>::value>::type* =
+            nullptr>
+EZ_CONSTEXPR14 maybe_interval<typename Interval1::type> intersection(Interval1 const& lhs,
+                                                                     Interval2 const& rhs)
+  noexcept(is_nothrow_totally_ordered<typename Interval1::type>::value) {
+	static_assert(std::is_same<typename Interval1::type, typename Interval2::type>::value,
+	              "Underlying types of intervals must be equal");
+
+	// For equal bounds the open one is chosen
+	bool const lower_from_lhs = (rhs.lower() < lhs.lower()) |
+	                            ((rhs.lower() == lhs.lower()) & lhs.left_open());
+	bool const upper_from_lhs = (lhs.upper() < rhs.upper()) |
+	                            ((lhs.upper() == rhs.upper()) & lhs.right_open());
+	return {lower_from_lhs ? lhs.lower() : rhs.lower(),
+	        upper_from_lhs ? lhs.upper() : rhs.upper(),
+	        lower_from_lhs ? lhs.left_open() : rhs.left_open(),
+	        upper_from_lhs ? lhs.right_open() : rhs.right_open()};
+}
+
+/** Returns true if \a a is a subset of \a b. The empty interval is a subset of every interval. */
+template <typename Interval1, typename Interval2,
+          typename std::enable_if<detail::maybe_arguments<Interval1, Interval2>::value>::type* =
+            nullptr>
+EZ_CONSTEXPR14 bool subset(Interval1 const& a, Interval2 const& b)
+  noexcept(is_nothrow_totally_ordered<typename Interval1::type>::value) {
+	bool const lower_within = (b.lower() < a.lower()) |
+	                          ((b.lower() == a.lower()) & (a.left_open() | b.left_closed()));
+	bool const upper_within = (a.upper() < b.upper()) |
+	                          ((a.upper() == b.upper()) & (a.right_open() | b.right_closed()));
+	return maybe_interval<typename Interval1::type>{a}.empty() | (lower_within & upper_within);
+}
+
+/** Returns true if \a a is a superset of \a b. */
+template <typename Interval1, typename Interval2,
+          typename std::enable_if<detail::maybe_arguments<Interval1, Interval2>::value>::type* =
+            nullptr>
+EZ_CONSTEXPR14 bool superset(Interval1 const& a, Interval2 const& b)
+  noexcept(is_nothrow_totally_ordered<typename Interval1::type>::value) {
+	return subset(b, a);
+}
+
+/** Returns the interval sum of \a lhs and \a rhs, which is empty if either of them is empty. */
+template <typename T>
+EZ_CONSTEXPR14 maybe_interval<T> operator+(maybe_interval<T> const& lhs,
+                                           maybe_interval<T> const& rhs) {
+	// An empty result is given the bounds of maybe_interval<T>{} without branching
+	bool const empty = lhs.empty() | rhs.empty();
+	bool const left_open = empty | lhs.left_open() | rhs.left_open();
+	bool const right_open = empty | lhs.right_open() | rhs.right_open();
+	return {empty ? T{} : lhs.lower() + rhs.lower(), empty ? T{} : lhs.upper() + rhs.upper(),
+	        left_open, right_open};
+}
+
+/** Returns the interval difference of \a lhs and \a rhs, which is empty if either of them is
+ *  empty. */
+template <typename T>
+EZ_CONSTEXPR14 maybe_interval<T> operator-(maybe_interval<T> const& lhs,
+                                           maybe_interval<T> const& rhs) {
+	bool const empty = lhs.empty() | rhs.empty();
+	bool const left_open = empty | lhs.left_open() | rhs.right_open();
+	bool const right_open = empty | lhs.right_open() | rhs.left_open();
+	return {empty ? T{} : lhs.lower() - rhs.upper(), empty ? T{} : lhs.upper() - rhs.lower(),
+	        left_open, right_open};
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& stream, maybe_interval<T> const& r) {
+	if(r.empty()) {
+		return stream << "{}";
+	}
+	return stream << r.value();
+}
+
+}
+
+#endif
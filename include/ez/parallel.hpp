@@ -0,0 +1,361 @@
+/******************************************************************//**
+ * \file   parallel.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_A9B21A0C_FC4C_4347_B71C_CC1C8667CEDB
+#define INCLUDE_GUARD_A9B21A0C_FC4C_4347_B71C_CC1C8667CEDB
+
+#include "ez/interval.hpp"
+#include "ez/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ez {
+
+namespace detail {
+
+// default_grain_size splits size elements into roughly 8 pieces for each thread that can run them,
+// which leaves enough pieces to steal when the work per element is irregular
+template <typename Difference>
+Difference default_grain_size(Difference size, thread_pool const& pool) {
+	auto const pieces = static_cast<Difference>(8 * (pool.size() + 1));
+	return std::max(Difference{1}, size / pieces);
+}
+
+template <typename Iterator, typename Difference, typename Function>
+void parallel_for(task_group& group, Iterator first, Iterator last, Difference grain_size,
+                  Function const& f) {
+	// Hand the upper half to the pool until the remaining piece is small enough to run here. The
+	// halves are pushed largest first, so thieves take the largest pieces.
+	while(last - first > grain_size) {
+		auto const middle = first + (last - first) / 2;
+		group.run([&group, middle, last, grain_size, &f]{
+			detail::parallel_for(group, middle, last, grain_size, f);
+		});
+		last = middle;
+	}
+
+	for(; first != last; ++first) {
+		f(*first);
+	}
+}
+
+
+// transform_reduce reduces the elements in [first, last) by splitting it in half until each piece
+// has at most leaf_size elements. The shape of the tree only depends on last - first and
+// leaf_size, and each node combines its halves in order, so the result does not depend on which
+// threads run which pieces.
+template <typename T, typename Iterator, typename Difference, typename BinaryOperation,
+          typename UnaryOperation>
+T transform_reduce(thread_pool& pool, Iterator first, Iterator last, Difference leaf_size,
+                   BinaryOperation const& reduce, UnaryOperation const& transform) {
+	if(last - first <= leaf_size) {
+		T result = transform(*first);
+		while(++first != last) {
+			result = reduce(std::move(result), transform(*first));
+		}
+		return result;
+	}
+
+	auto const middle = first + (last - first) / 2;
+	std::unique_ptr<T> upper;
+	task_group group{pool};
+	group.run([&pool, &upper, middle, last, leaf_size, &reduce, &transform]{
+		upper.reset(new T(detail::transform_reduce<T>(pool, middle, last, leaf_size,
+		                                              reduce, transform)));
+	});
+
+	auto lower = detail::transform_reduce<T>(pool, first, middle, leaf_size, reduce, transform);
+	group.wait();
+	return reduce(std::move(lower), std::move(*upper));
+}
+
+// identity is the transform used by parallel_reduce
+struct identity {
+	template <typename T>
+	T const& operator()(T const& t) const noexcept {
+		return t;
+	}
+};
+
+}
+
+/** Calls \a f with each element of the interval \a r, in parallel, using the threads in \a pool.
+ *
+ *  The interval is split recursively in half until each piece has at most \a grain_size elements,
+ *  and idle threads steal the largest remaining pieces, which balances the load when the work done
+ *  for each element varies. If \a grain_size is not positive, it is chosen from the size of \a r
+ *  and the number of threads.
+ *
+ *  The thread calling parallel_for also runs pieces until all of \a r is done, so parallel_for can
+ *  be called from inside \a f. If \a f throws, the remaining pieces are skipped and the first
+ *  exception is rethrown.
+ *
+ *  The iterators of Interval must be random access, such as for ez::indices and ez::iterate on a
+ *  std::vector.
+ *
+ *  \code
+ *  std::vector<int> stopping_times(1000000);
+ *  ez::parallel_for(ez::indices(stopping_times), [&](std::size_t i) {
+ *      stopping_times[i] = collatz_stopping_time(i + 1);
+ *  });
+ *  \endcode */
+template <typename Interval, typename Function,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+void parallel_for(thread_pool& pool, Interval const& r, Function f,
+                  typename Interval::difference_type grain_size = 0) {
+	typedef typename Interval::iterator iterator;
+	static_assert(std::is_same<typename std::iterator_traits<iterator>::iterator_category,
+	                           std::random_access_iterator_tag>::value,
+	              "parallel_for requires an interval with random access iterators");
+
+	auto const first = r.begin();
+	auto const last = r.end();
+	if(grain_size <= 0) {
+		grain_size = detail::default_grain_size(last - first, pool);
+	}
+
+	task_group group{pool};
+#ifdef EZ_NO_EXCEPTIONS
+	detail::parallel_for(group, first, last, grain_size, f);
+#else
+	try {
+		detail::parallel_for(group, first, last, grain_size, f);
+	} catch(...) {
+		group.cancel(std::current_exception());
+	}
+#endif
+	group.wait();
+}
+
+/** Calls \a f with each element of the interval \a r, in parallel, using
+ *  ez::default_thread_pool(). */
+template <typename Interval, typename Function,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+void parallel_for(Interval const& r, Function f,
+                  typename Interval::difference_type grain_size = 0) {
+	parallel_for(default_thread_pool(), r, std::move(f), grain_size);
+}
+
+/** The number of elements that parallel_reduce and parallel_transform_reduce combine sequentially
+ *  by default. */
+static std::ptrdiff_t const default_reduce_leaf_size = 2048;
+
+/** Returns the result of combining \a init with transform(x) for every element x of the interval
+ *  \a r using \a reduce, in parallel, using the threads in \a pool.
+ *
+ *  Unlike std::transform_reduce with an execution policy, the order in which values are combined
+ *  is fixed. The interval is split recursively in half until each piece has at most \a leaf_size
+ *  elements, each piece is reduced from left to right, and the two halves of each split are
+ *  combined as reduce(lower, upper). Finally the result is combined as reduce(init, result). This
+ *  means that the result only depends on \a r and \a leaf_size, so floating point sums are
+ *  identical for any number of threads. \a reduce must be associative for the result to equal a
+ *  sequential reduction, but it does not need to be commutative.
+ *
+ *  \code
+ *  auto const harmonic = ez::parallel_transform_reduce(
+ *    ez::make_interval[1][n], 0.0, std::plus<double>{}, [](int i){ return 1.0 / i; });
+ *  \endcode */
+template <typename Interval, typename T, typename BinaryOperation, typename UnaryOperation,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+T parallel_transform_reduce(thread_pool& pool, Interval const& r, T init, BinaryOperation reduce,
+                            UnaryOperation transform,
+                            typename Interval::difference_type leaf_size =
+                              default_reduce_leaf_size) {
+	typedef typename Interval::iterator iterator;
+	static_assert(std::is_same<typename std::iterator_traits<iterator>::iterator_category,
+	                           std::random_access_iterator_tag>::value,
+	              "parallel_transform_reduce requires an interval with random access iterators");
+
+	auto const first = r.begin();
+	auto const last = r.end();
+	if(first == last) {
+		return init;
+	}
+
+	if(leaf_size <= 0) {
+		leaf_size = default_reduce_leaf_size;
+	}
+
+	return reduce(std::move(init),
+	              detail::transform_reduce<T>(pool, first, last, leaf_size, reduce, transform));
+}
+
+/** Calls ez::parallel_transform_reduce using ez::default_thread_pool(). */
+template <typename Interval, typename T, typename BinaryOperation, typename UnaryOperation,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+T parallel_transform_reduce(Interval const& r, T init, BinaryOperation reduce,
+                            UnaryOperation transform,
+                            typename Interval::difference_type leaf_size =
+                              default_reduce_leaf_size) {
+	return parallel_transform_reduce(default_thread_pool(), r, std::move(init), std::move(reduce),
+	                                 std::move(transform), leaf_size);
+}
+
+/** Returns the result of combining \a init with every element of the interval \a r using
+ *  \a reduce, in parallel, using the threads in \a pool. The order of the operations is fixed in
+ *  the same way as ez::parallel_transform_reduce, so the result is identical for any number of
+ *  threads.
+ *
+ *  \code
+ *  auto const sum = ez::parallel_reduce(ez::make_interval[0](n), 0LL, std::plus<long long>{});
+ *  \endcode */
+template <typename Interval, typename T, typename BinaryOperation,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+T parallel_reduce(thread_pool& pool, Interval const& r, T init, BinaryOperation reduce,
+                  typename Interval::difference_type leaf_size = default_reduce_leaf_size) {
+	return parallel_transform_reduce(pool, r, std::move(init), std::move(reduce),
+	                                 detail::identity{}, leaf_size);
+}
+
+/** Calls ez::parallel_reduce using ez::default_thread_pool(). */
+template <typename Interval, typename T, typename BinaryOperation,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+T parallel_reduce(Interval const& r, T init, BinaryOperation reduce,
+                  typename Interval::difference_type leaf_size = default_reduce_leaf_size) {
+	return parallel_reduce(default_thread_pool(), r, std::move(init), std::move(reduce), leaf_size);
+}
+
+/** Writes f(x) for every element x of the interval \a r, in order, to \a out, computing the
+ *  values in parallel using the threads in \a pool. Returns the output iterator one past the last
+ *  element written.
+ *
+ *  The interval is split into blocks of \a block_size elements. At most \a blocks_in_flight blocks
+ *  are computed or waiting to be written at any one time, so the memory used does not depend on
+ *  the size of \a r. The calling thread writes each block to \a out as soon as it and all blocks
+ *  before it are finished, and runs queued blocks while waiting. Only the calling thread uses
+ *  \a out, so it can be any output iterator, such as a std::ostream_iterator.
+ *
+ *  If \a block_size is not positive, 1024 is used, and if \a blocks_in_flight is not positive,
+ *  twice the number of threads that can run blocks is used. If \a f throws, no more blocks are
+ *  written and the first exception is rethrown.
+ *
+ *  \code
+ *  ez::parallel_transform(ez::make_interval[1](101),
+ *                         std::ostream_iterator<int>(std::cout, ", "),
+ *                         collatz_stopping_time);
+ *  \endcode */
+template <typename Interval, typename OutputIterator, typename UnaryOperation,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+OutputIterator parallel_transform(thread_pool& pool, Interval const& r, OutputIterator out,
+                                  UnaryOperation f,
+                                  typename Interval::difference_type block_size = 0,
+                                  std::size_t blocks_in_flight = 0) {
+	typedef typename Interval::iterator iterator;
+	typedef typename Interval::difference_type difference_type;
+	typedef typename std::decay<decltype(f(*std::declval<iterator>()))>::type value_type;
+	static_assert(std::is_same<typename std::iterator_traits<iterator>::iterator_category,
+	                           std::random_access_iterator_tag>::value,
+	              "parallel_transform requires an interval with random access iterators");
+
+	struct block {
+		std::vector<value_type> values;
+		std::atomic<bool> ready;
+	};
+
+	if(block_size <= 0) {
+		block_size = 1024;
+	}
+
+	if(blocks_in_flight == 0) {
+		blocks_in_flight = 2 * (pool.size() + 1);
+	}
+
+	auto const first = r.begin();
+	auto const size = r.end() - first;
+	auto const block_count = size == 0 ? 0 : (size - 1) / block_size + 1;
+	std::vector<block> blocks(std::min(static_cast<std::size_t>(block_count), blocks_in_flight));
+
+	task_group group{pool};
+	auto const submit = [&](difference_type index) {
+		auto& b = blocks[static_cast<std::size_t>(index) % blocks.size()];
+		auto const lower = first + index * block_size;
+		auto const upper = index + 1 == block_count ? first + size : lower + block_size;
+		group.run([&b, &f, lower, upper]{
+			for(auto it = lower; it != upper; ++it) {
+				b.values.push_back(f(*it));
+			}
+			b.ready.store(true, std::memory_order_release);
+		});
+	};
+
+	for(difference_type i = 0; i < static_cast<difference_type>(blocks.size()); ++i) {
+		blocks[static_cast<std::size_t>(i)].ready = false;
+		blocks[static_cast<std::size_t>(i)].values.reserve(static_cast<std::size_t>(block_size));
+		submit(i);
+	}
+
+	for(difference_type i = 0; i < block_count; ++i) {
+		auto& b = blocks[static_cast<std::size_t>(i) % blocks.size()];
+		while(!b.ready.load(std::memory_order_acquire)) {
+			if(group.cancelled()) {
+				group.wait();
+			}
+
+			if(!pool.try_run_one()) {
+				std::this_thread::yield();
+			}
+		}
+
+		for(auto& value : b.values) {
+			*out = std::move(value);
+			++out;
+		}
+
+		b.values.clear();
+		b.ready.store(false, std::memory_order_relaxed);
+		if(i + static_cast<difference_type>(blocks.size()) < block_count) {
+			submit(i + static_cast<difference_type>(blocks.size()));
+		}
+	}
+
+	group.wait();
+	return out;
+}
+
+/** Calls ez::parallel_transform using ez::default_thread_pool(). */
+template <typename Interval, typename OutputIterator, typename UnaryOperation,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+OutputIterator parallel_transform(Interval const& r, OutputIterator out, UnaryOperation f,
+                                  typename Interval::difference_type block_size = 0,
+                                  std::size_t blocks_in_flight = 0) {
+	return parallel_transform(default_thread_pool(), r, std::move(out), std::move(f), block_size,
+	                          blocks_in_flight);
+}
+
+}
+
+#endif
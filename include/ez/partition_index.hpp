@@ -0,0 +1,126 @@
+/******************************************************************//**
+ * \file   partition_index.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_07D79ADA_1622_4F30_98E4_979EDB227F69
+#define INCLUDE_GUARD_07D79ADA_1622_4F30_98E4_979EDB227F69
+
+#include "ez/flat_index.hpp"
+#include "ez/interval.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace ez {
+
+/** Finds which of a sorted list of touching intervals contains a value.
+ *
+ *  The intervals are given in order, and the upper bound of each must be the lower bound of the
+ *  next, so that every value from the lower bound of the first to the upper bound of the last is
+ *  in exactly one of them. Otherwise invalid_partition is thrown.
+ *
+ *  The bounds are searched with the same flat index of 16-key nodes as interval_map, which takes
+ *  one node per level and no branches on the value. Partitions of up to 15 intervals, which have
+ *  up to 16 bounds, only have a single node. buckets() looks up a whole array of values at a time.
+ *
+ *  \code
+ *  ez::partition_index<int> const brackets = {ez::make_interval[0](100),
+ *                                             ez::make_interval[100](500),
+ *                                             ez::make_interval[500](1000)};
+ *  assert(brackets.bucket(250) == 1);
+ *  assert(brackets.bucket(1000) == brackets.size());
+ *  \endcode */
+template <typename T>
+class partition_index {
+public:
+	typedef T type;
+	typedef ropen_interval<T> value_type;
+	typedef std::size_t size_type;
+
+	partition_index() = default;
+
+	template <typename InputIterator>
+	partition_index(InputIterator first, InputIterator last) {
+		std::vector<T> bounds;
+		for(; first != last; ++first) {
+			ropen_interval<T> const r = *first;
+			if(bounds.empty()) {
+				bounds.push_back(r.lower());
+			} else if(bounds.back() != r.lower()) {
+				EZ_THROW(invalid_partition{});
+			}
+			bounds.push_back(r.upper());
+		}
+		m_size = bounds.empty() ? 0 : bounds.size() - 1;
+		m_index = detail::flat_index<T>(bounds.begin(), bounds.end());
+		m_bounds.swap(bounds);
+	}
+
+	partition_index(std::initializer_list<ropen_interval<T>> list)
+	: partition_index(list.begin(), list.end()) {
+	}
+
+	/** Returns the number of intervals. */
+	size_type size() const {
+		return m_size;
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	ropen_interval<T> operator[](size_type i) const {
+		return {m_bounds[i], m_bounds[i + 1], detail::unchecked_tag{}};
+	}
+
+	/** Returns the position of the interval containing \a value, or size() if there is none. */
+	size_type bucket(T const& value) const {
+		// The bounds are the lower bound of each interval followed by the upper bound of the last,
+		// so a count of 0 or size() + 1 is outside of every interval. Unsigned wrapping makes both
+		// of these at least size().
+		auto const bucket = m_index.count_not_greater(value) - 1;
+		return (bucket < m_size) ? bucket : m_size;
+	}
+
+	/** Sets \a out[i] to bucket(\a values[i]) for each of the \a n values. */
+	void buckets(T const* values, std::size_t n, size_type* out) const {
+		for(std::size_t i = 0; i < n; ++i) {
+			out[i] = bucket(values[i]);
+		}
+	}
+
+private:
+	std::vector<T> m_bounds;
+	detail::flat_index<T> m_index;
+	size_type m_size = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,278 @@
+/******************************************************************//**
+ * \file   rounding.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_1DAEF1FA_BFBB_4C51_9325_B3E79CD52539
+#define INCLUDE_GUARD_1DAEF1FA_BFBB_4C51_9325_B3E79CD52539
+
+#include "ez/interval.hpp"
+
+#include <algorithm>
+#include <cfenv>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ez {
+
+/** A rounding_unavailable exception is thrown when the floating point rounding mode cannot be
+ *  changed. */
+struct rounding_unavailable : std::runtime_error {
+	rounding_unavailable()
+	: std::runtime_error{"Cannot change the floating point rounding mode"} {
+	}
+};
+
+namespace detail {
+
+// opaque returns x, but stops the compiler from assuming anything about the value. This keeps
+// the compiler from rewriting -((-a) - b) as a + b, or -(a * b) as a * -b, which are only the same
+// when rounding to nearest.
+template <typename T>
+T opaque(T x) noexcept {
+#if defined(__GNUC__)
+	__asm__ __volatile__("" : "+m"(x));
+	return x;
+#else
+	return *static_cast<T volatile*>(&x);
+#endif
+}
+
+#if defined(__GNUC__) && defined(__SSE2_MATH__)
+// Keep float and double in their SSE registers
+inline float opaque(float x) noexcept {
+	__asm__ __volatile__("" : "+x"(x));
+	return x;
+}
+
+inline double opaque(double x) noexcept {
+	__asm__ __volatile__("" : "+x"(x));
+	return x;
+}
+#endif
+
+// With the rounding mode set to round upwards, up() rounds the result of an operation towards
+// positive infinity and down() negates the operation to round it towards negative infinity
+
+struct addition {
+	template <typename T>
+	static T up(T a, T b) noexcept {
+		return opaque(a) + b;
+	}
+
+	template <typename T>
+	static T down(T a, T b) noexcept {
+		return -opaque(opaque(-a) - b);
+	}
+};
+
+struct subtraction {
+	template <typename T>
+	static T up(T a, T b) noexcept {
+		return opaque(a) - b;
+	}
+
+	template <typename T>
+	static T down(T a, T b) noexcept {
+		return -opaque(opaque(-a) + b);
+	}
+};
+
+struct multiplication {
+	template <typename T>
+	static T up(T a, T b) noexcept {
+		return opaque(a) * b;
+	}
+
+	template <typename T>
+	static T down(T a, T b) noexcept {
+		return -opaque(opaque(-a) * b);
+	}
+};
+
+struct division {
+	template <typename T>
+	static T up(T a, T b) noexcept {
+		return opaque(a) / b;
+	}
+
+	template <typename T>
+	static T down(T a, T b) noexcept {
+		return -opaque(opaque(-a) / b);
+	}
+};
+
+// outward_bounds picks the smallest of the rounded down candidates and the largest of the rounded
+// up candidates, preferring closed bounds when two are equal as operator*= does
+template <typename T>
+interval<T> outward_bounds(std::pair<T, bool> const (&lower)[4],
+                           std::pair<T, bool> const (&upper)[4]) {
+	auto const l = *std::min_element(std::begin(lower), std::end(lower));
+	auto const u = *std::max_element(std::begin(upper), std::end(upper),
+	                                 lt_first_gt_second<T, bool>);
+	return {l.first, u.first, l.second, u.second};
+}
+
+}
+
+/** Interval arithmetic on floating point types where every bound is rounded outwards, so that the
+ *  result always contains the exact result.
+ *
+ *  The constructor sets the rounding mode of the current thread to round upwards and the
+ *  destructor restores the previous mode. The mode is changed once for all of the operations done
+ *  with the object, and lower bounds are rounded downwards by negating the operation instead of
+ *  switching the mode back and forth. Only use the object on the thread that created it, and
+ *  remember that all other floating point arithmetic in its lifetime also rounds upwards. When
+ *  using GCC, compile with -frounding-math to make sure that no arithmetic is done at compile time
+ *  or moved outside of the lifetime of the object.
+ *
+ *  The openness of the results is the same as for the operators of interval<T>.
+ *
+ *  \code
+ *  auto const one = ez::make_interval[1.0][1.0];
+ *  auto const three = ez::make_interval[3.0][3.0];
+ *  {
+ *      ez::outward_rounding rounding;
+ *      auto const r = rounding.divide(one, three);
+ *      assert(r.lower() < r.upper()); // r contains exactly 1/3
+ *  }
+ *  \endcode */
+class outward_rounding {
+public:
+	outward_rounding()
+	: m_previous{std::fegetround()} {
+		if(std::fesetround(FE_UPWARD) != 0) {
+			EZ_THROW(rounding_unavailable{});
+		}
+	}
+
+	outward_rounding(outward_rounding const&) = delete;
+	outward_rounding& operator=(outward_rounding const&) = delete;
+
+	~outward_rounding() {
+		std::fesetround(m_previous);
+	}
+
+	template <typename Interval1, typename Interval2,
+	          typename std::enable_if<is_interval<Interval1>::value &&
+	                                  is_interval<Interval2>::value>::type* = nullptr>
+	interval<typename Interval1::type> add(Interval1 const& l, Interval2 const& r) const {
+		check_types<Interval1, Interval2>();
+		return {detail::addition::down(l.lower(), r.lower()),
+		        detail::addition::up(l.upper(), r.upper()),
+		        l.left_open() || r.left_open(), l.right_open() || r.right_open()};
+	}
+
+	template <typename Interval1, typename Interval2,
+	          typename std::enable_if<is_interval<Interval1>::value &&
+	                                  is_interval<Interval2>::value>::type* = nullptr>
+	interval<typename Interval1::type> subtract(Interval1 const& l, Interval2 const& r) const {
+		check_types<Interval1, Interval2>();
+		return {detail::subtraction::down(l.lower(), r.upper()),
+		        detail::subtraction::up(l.upper(), r.lower()),
+		        l.left_open() || r.right_open(), l.right_open() || r.left_open()};
+	}
+
+	template <typename Interval1, typename Interval2,
+	          typename std::enable_if<is_interval<Interval1>::value &&
+	                                  is_interval<Interval2>::value>::type* = nullptr>
+	interval<typename Interval1::type> multiply(Interval1 const& l, Interval2 const& r) const {
+		check_types<Interval1, Interval2>();
+		typedef typename Interval1::type T;
+		auto const zero = T{0};
+		bool const open[] = {
+		  (l.left_open() && r.left_open())   || (l.left_open() && r.lower() != zero) ||
+		  (r.left_open() && l.lower() != zero),
+		  (l.left_open() && r.right_open())  || (l.left_open() && r.upper() != zero) ||
+		  (r.right_open() && l.lower() != zero),
+		  (l.right_open() && r.left_open())  || (l.right_open() && r.lower() != zero) ||
+		  (r.left_open() && l.upper() != zero),
+		  (l.right_open() && r.right_open()) || (l.right_open() && r.upper() != zero) ||
+		  (r.right_open() && l.upper() != zero)
+		};
+
+		return candidates<detail::multiplication>(l, r, open);
+	}
+
+	/** Throws divide_by_zero if \a r contains zero. */
+	template <typename Interval1, typename Interval2,
+	          typename std::enable_if<is_interval<Interval1>::value &&
+	                                  is_interval<Interval2>::value>::type* = nullptr>
+	interval<typename Interval1::type> divide(Interval1 const& l, Interval2 const& r) const {
+		check_types<Interval1, Interval2>();
+		typedef typename Interval1::type T;
+		auto const zero = T{0};
+		if(contains(make_closed(r), zero)) {
+			EZ_THROW(divide_by_zero{});
+		}
+
+		bool const open[] = {
+		  l.lower() != zero && (l.left_open() || r.left_open()),
+		  l.lower() != zero && (l.left_open() || r.right_open()),
+		  l.upper() != zero && (l.right_open() || r.left_open()),
+		  l.upper() != zero && (l.right_open() || r.right_open())
+		};
+
+		return candidates<detail::division>(l, r, open);
+	}
+
+private:
+	template <typename Interval1, typename Interval2>
+	static void check_types() {
+		static_assert(std::is_same<typename Interval1::type, typename Interval2::type>::value,
+		              "Underlying types of intervals must be equal");
+		static_assert(std::is_floating_point<typename Interval1::type>::value,
+		              "Outward rounding is only needed for floating point types");
+	}
+
+	// candidates combines each bound of l with each bound of r, rounding down for the lower bound
+	// of the result and up for the upper bound
+	template <typename Operation, typename Interval1, typename Interval2,
+	          typename T = typename Interval1::type>
+	static interval<T> candidates(Interval1 const& l, Interval2 const& r, bool const (&open)[4]) {
+		std::pair<T, bool> const lower[] = {
+		  {Operation::down(l.lower(), r.lower()), open[0]},
+		  {Operation::down(l.lower(), r.upper()), open[1]},
+		  {Operation::down(l.upper(), r.lower()), open[2]},
+		  {Operation::down(l.upper(), r.upper()), open[3]}
+		};
+		std::pair<T, bool> const upper[] = {
+		  {Operation::up(l.lower(), r.lower()), open[0]},
+		  {Operation::up(l.lower(), r.upper()), open[1]},
+		  {Operation::up(l.upper(), r.lower()), open[2]},
+		  {Operation::up(l.upper(), r.upper()), open[3]}
+		};
+		return detail::outward_bounds(lower, upper);
+	}
+
+	int m_previous;
+};
+
+}
+
+#endif
@@ -0,0 +1,285 @@
+/******************************************************************//**
+ * \file   simd.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_2FA39395_7418_4D01_BFA6_3AE312306AE8
+#define INCLUDE_GUARD_2FA39395_7418_4D01_BFA6_3AE312306AE8
+
+#include <cstddef>
+#include <cstdint>
+
+// EZ_SIMD is defined when the compiler is targeting AVX-512 or AVX2, unless EZ_NO_SIMD is defined.
+// The kernels that use it work on whole vectors and leave the remaining elements to scalar code,
+// so the results are identical whichever is used.
+#if !defined(EZ_NO_SIMD) && (defined(__AVX512F__) || defined(__AVX2__))
+#define EZ_SIMD
+#include <immintrin.h>
+#endif
+
+namespace ez {
+
+namespace detail {
+
+inline std::size_t popcount(std::uint64_t x) noexcept {
+#if defined(__GNUC__)
+	return static_cast<std::size_t>(__builtin_popcountll(x));
+#else
+	std::size_t count = 0;
+	for(; x != 0; x &= x - 1) {
+		++count;
+	}
+	return count;
+#endif
+}
+
+#ifdef EZ_SIMD
+
+// simd<T> wraps the intrinsics for a vector of width values of T. Every type has set1, load, lt,
+// le and to_bits, which returns one bit for each lane of a mask. float and double also have the
+// arithmetic, eq, ne, select and from_bits.
+template <typename T>
+struct simd;
+
+#if defined(__AVX512F__)
+
+template <>
+struct simd<double> {
+	typedef double type;
+	typedef __m512d vec;
+	typedef __mmask8 mask;
+	static std::size_t const width = 8;
+
+	static vec set1(double x) { return _mm512_set1_pd(x); }
+	static vec load(double const* p) { return _mm512_loadu_pd(p); }
+	static void store(double* p, vec v) { _mm512_storeu_pd(p, v); }
+	static vec zero() { return _mm512_setzero_pd(); }
+	static vec add(vec a, vec b) { return _mm512_add_pd(a, b); }
+	static vec sub(vec a, vec b) { return _mm512_sub_pd(a, b); }
+	static vec mul(vec a, vec b) { return _mm512_mul_pd(a, b); }
+	static vec div(vec a, vec b) { return _mm512_div_pd(a, b); }
+	static mask lt(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+	static mask le(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+	static mask eq(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+	static mask ne(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+	static vec select(mask m, vec a, vec b) { return _mm512_mask_blend_pd(m, b, a); }
+	static mask from_bits(unsigned b) { return static_cast<mask>(b); }
+	static unsigned to_bits(mask m) { return m; }
+};
+
+template <>
+struct simd<float> {
+	typedef float type;
+	typedef __m512 vec;
+	typedef __mmask16 mask;
+	static std::size_t const width = 16;
+
+	static vec set1(float x) { return _mm512_set1_ps(x); }
+	static vec load(float const* p) { return _mm512_loadu_ps(p); }
+	static void store(float* p, vec v) { _mm512_storeu_ps(p, v); }
+	static vec zero() { return _mm512_setzero_ps(); }
+	static vec add(vec a, vec b) { return _mm512_add_ps(a, b); }
+	static vec sub(vec a, vec b) { return _mm512_sub_ps(a, b); }
+	static vec mul(vec a, vec b) { return _mm512_mul_ps(a, b); }
+	static vec div(vec a, vec b) { return _mm512_div_ps(a, b); }
+	static mask lt(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+	static mask le(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+	static mask eq(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+	static mask ne(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+	static vec select(mask m, vec a, vec b) { return _mm512_mask_blend_ps(m, b, a); }
+	static mask from_bits(unsigned b) { return static_cast<mask>(b); }
+	static unsigned to_bits(mask m) { return m; }
+};
+
+template <>
+struct simd<std::int32_t> {
+	typedef std::int32_t type;
+	typedef __m512i vec;
+	typedef __mmask16 mask;
+	static std::size_t const width = 16;
+
+	static vec set1(std::int32_t x) { return _mm512_set1_epi32(x); }
+	static vec load(std::int32_t const* p) { return _mm512_loadu_si512(p); }
+	static mask lt(vec a, vec b) { return _mm512_cmplt_epi32_mask(a, b); }
+	static mask le(vec a, vec b) { return _mm512_cmple_epi32_mask(a, b); }
+	static unsigned to_bits(mask m) { return m; }
+};
+
+template <>
+struct simd<std::int64_t> {
+	typedef std::int64_t type;
+	typedef __m512i vec;
+	typedef __mmask8 mask;
+	static std::size_t const width = 8;
+
+	static vec set1(std::int64_t x) { return _mm512_set1_epi64(x); }
+	static vec load(std::int64_t const* p) { return _mm512_loadu_si512(p); }
+	static mask lt(vec a, vec b) { return _mm512_cmplt_epi64_mask(a, b); }
+	static mask le(vec a, vec b) { return _mm512_cmple_epi64_mask(a, b); }
+	static unsigned to_bits(mask m) { return m; }
+};
+
+// The masks are integers, so the usual bitwise operators combine them
+template <typename Mask>
+Mask mask_and(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+template <typename Mask>
+Mask mask_or(Mask a, Mask b) { return static_cast<Mask>(a | b); }
+template <typename Mask>
+Mask mask_andnot(Mask a, Mask b) { return static_cast<Mask>(a & ~b); }
+template <typename Mask>
+Mask mask_select(Mask m, Mask a, Mask b) { return static_cast<Mask>((m & a) | (~m & b)); }
+
+#else
+
+// The masks are vectors with every bit of a lane set or clear. The integer masks are cast to the
+// floating point vector of the same lane width so that mask_and and friends apply to them too.
+template <>
+struct simd<double> {
+	typedef double type;
+	typedef __m256d vec;
+	typedef __m256d mask;
+	static std::size_t const width = 4;
+
+	static vec set1(double x) { return _mm256_set1_pd(x); }
+	static vec load(double const* p) { return _mm256_loadu_pd(p); }
+	static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+	static vec zero() { return _mm256_setzero_pd(); }
+	static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+	static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+	static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+	static vec div(vec a, vec b) { return _mm256_div_pd(a, b); }
+	static mask lt(vec a, vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	static mask le(vec a, vec b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+	static mask eq(vec a, vec b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+	static mask ne(vec a, vec b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+	static vec select(mask m, vec a, vec b) { return _mm256_blendv_pd(b, a, m); }
+
+	static mask from_bits(unsigned b) {
+		auto const lanes = _mm256_set_epi64x(8, 4, 2, 1);
+		auto const bits = _mm256_and_si256(_mm256_set1_epi64x(b), lanes);
+		return _mm256_castsi256_pd(_mm256_cmpeq_epi64(bits, lanes));
+	}
+
+	static unsigned to_bits(mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+};
+
+template <>
+struct simd<float> {
+	typedef float type;
+	typedef __m256 vec;
+	typedef __m256 mask;
+	static std::size_t const width = 8;
+
+	static vec set1(float x) { return _mm256_set1_ps(x); }
+	static vec load(float const* p) { return _mm256_loadu_ps(p); }
+	static void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+	static vec zero() { return _mm256_setzero_ps(); }
+	static vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+	static vec sub(vec a, vec b) { return _mm256_sub_ps(a, b); }
+	static vec mul(vec a, vec b) { return _mm256_mul_ps(a, b); }
+	static vec div(vec a, vec b) { return _mm256_div_ps(a, b); }
+	static mask lt(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static mask le(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	static mask eq(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	static mask ne(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+	static vec select(mask m, vec a, vec b) { return _mm256_blendv_ps(b, a, m); }
+
+	static mask from_bits(unsigned b) {
+		auto const lanes = _mm256_set_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+		auto const bits = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(b)), lanes);
+		return _mm256_castsi256_ps(_mm256_cmpeq_epi32(bits, lanes));
+	}
+
+	static unsigned to_bits(mask m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+};
+
+// AVX2 only has a signed greater than for integers, so a <= b is !(b < a)
+template <>
+struct simd<std::int32_t> {
+	typedef std::int32_t type;
+	typedef __m256i vec;
+	typedef __m256 mask;
+	static std::size_t const width = 8;
+
+	static vec set1(std::int32_t x) { return _mm256_set1_epi32(x); }
+
+	static vec load(std::int32_t const* p) {
+		return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+	}
+
+	static mask lt(vec a, vec b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)); }
+
+	static mask le(vec a, vec b) {
+		return _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpgt_epi32(a, b),
+		                                            _mm256_set1_epi32(-1)));
+	}
+
+	static unsigned to_bits(mask m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+};
+
+template <>
+struct simd<std::int64_t> {
+	typedef std::int64_t type;
+	typedef __m256i vec;
+	typedef __m256d mask;
+	static std::size_t const width = 4;
+
+	static vec set1(std::int64_t x) { return _mm256_set1_epi64x(x); }
+
+	static vec load(std::int64_t const* p) {
+		return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+	}
+
+	static mask lt(vec a, vec b) { return _mm256_castsi256_pd(_mm256_cmpgt_epi64(b, a)); }
+
+	static mask le(vec a, vec b) {
+		return _mm256_castsi256_pd(_mm256_xor_si256(_mm256_cmpgt_epi64(a, b),
+		                                            _mm256_set1_epi64x(-1)));
+	}
+
+	static unsigned to_bits(mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+};
+
+inline __m256d mask_and(__m256d a, __m256d b) { return _mm256_and_pd(a, b); }
+inline __m256d mask_or(__m256d a, __m256d b) { return _mm256_or_pd(a, b); }
+inline __m256d mask_andnot(__m256d a, __m256d b) { return _mm256_andnot_pd(b, a); }
+inline __m256d mask_select(__m256d m, __m256d a, __m256d b) { return _mm256_blendv_pd(b, a, m); }
+
+inline __m256 mask_and(__m256 a, __m256 b) { return _mm256_and_ps(a, b); }
+inline __m256 mask_or(__m256 a, __m256 b) { return _mm256_or_ps(a, b); }
+inline __m256 mask_andnot(__m256 a, __m256 b) { return _mm256_andnot_ps(b, a); }
+inline __m256 mask_select(__m256 m, __m256 a, __m256 b) { return _mm256_blendv_ps(b, a, m); }
+
+#endif
+
+#endif
+
+}
+
+}
+
+#endif
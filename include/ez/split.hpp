@@ -0,0 +1,468 @@
+/******************************************************************//**
+ * \file   split.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_7D6E786C_1F6B_4F87_8DC3_20B11D2BC874
+#define INCLUDE_GUARD_7D6E786C_1F6B_4F87_8DC3_20B11D2BC874
+
+#include "ez/chunk.hpp"
+#include "ez/direct_iterator.hpp"
+#include "ez/interval.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace ez {
+
+namespace detail {
+
+// splittable<T> is true for types that can be split by the number of elements or by the length of
+// the interval
+template <typename T>
+struct splittable
+	: std::integral_constant<bool, is_countable<T>::value || std::is_floating_point<T>::value> {
+};
+
+// part returns the index-th of count parts of r, where the lower and upper values are only used
+// for the seams between parts. The outer ends keep the openness of r and the seams are closed on
+// the left and open on the right.
+template <typename T, typename Difference>
+interval<T> part(interval<T> const& r, Difference index, Difference count, T const& lower,
+                 T const& upper) {
+	auto const first = index == 0;
+	auto const last = index == count - 1;
+	return {first ? r.lower() : lower, last ? r.upper() : upper,
+	        first ? r.left_open() : false, last ? r.right_open() : true};
+}
+
+// equal_seam returns the start of the index-th of count equal parts of r. Countable types are
+// split so that the number of elements of each part differ by at most one, and other types are
+// split so that the lengths of each part are equal.
+template <typename T, typename Difference>
+T equal_seam(interval<T> const& r, Difference index, Difference count, std::true_type) {
+	auto const size = r.size();
+	return advanced(*r.begin(), size / count * index + std::min(index, size % count));
+}
+
+template <typename T, typename Difference>
+T equal_seam(interval<T> const& r, Difference index, Difference count, std::false_type) {
+	return r.lower() + (r.upper() - r.lower()) * static_cast<T>(index) / static_cast<T>(count);
+}
+
+// weighted_seam returns the start of the part whose preceding parts have a total weight of
+// before out of total. For countable types the seam is rounded to the nearest element and then
+// clamped so that this part and every one after it still gets at least one element. offset holds
+// the position of the previous seam and is updated.
+template <typename T, typename Difference, typename Weight>
+T weighted_seam(interval<T> const& r, Difference index, Difference count, Weight before,
+                Weight total, Difference& offset, std::true_type) {
+	auto const size = r.size();
+	auto const ideal = static_cast<long double>(size) * before / total + 0.5L;
+	auto seam = ideal < static_cast<long double>(size) ? static_cast<Difference>(ideal) : size;
+	seam = std::min(seam, size - (count - index));
+	offset = std::max(seam, offset + 1);
+	return advanced(*r.begin(), offset);
+}
+
+template <typename T, typename Difference, typename Weight>
+T weighted_seam(interval<T> const& r, Difference, Difference, Weight before, Weight total,
+                Difference&, std::false_type) {
+	return r.lower() + (r.upper() - r.lower()) * static_cast<T>(before) / static_cast<T>(total);
+}
+
+// check_part_count throws invalid_partition if r cannot be split into count non-empty parts
+template <typename T, typename Difference>
+void check_part_count(interval<T> const& r, Difference count, std::true_type) {
+	if(count <= 0 || count > r.size()) {
+		EZ_THROW(invalid_partition{});
+	}
+}
+
+template <typename T, typename Difference>
+void check_part_count(interval<T> const&, Difference count, std::false_type) {
+	if(count <= 0) {
+		EZ_THROW(invalid_partition{});
+	}
+}
+
+// check_seams throws invalid_partition if any of the count parts of r would be empty, where
+// next_seam() returns the upper seam of each part in turn. Countable types are already checked by
+// check_part_count, but a floating point interval can be too narrow to hold count increasing
+// seams, such as a singleton or an interval a few denormals wide.
+template <typename T, typename Difference, typename NextSeam>
+void check_seams(interval<T> const&, Difference, NextSeam, std::true_type) {
+}
+
+template <typename T, typename Difference, typename NextSeam>
+void check_seams(interval<T> const& r, Difference count, NextSeam next_seam, std::false_type) {
+	auto lower = r.lower();
+	for(Difference i = 0; i < count; ++i) {
+		auto const upper = next_seam();
+		auto const first = i == 0;
+		auto const last = i == count - 1;
+		if(!valid(first ? r.lower() : lower, last ? r.upper() : upper,
+		          first ? r.left_open() : false, last ? r.right_open() : true)) {
+			EZ_THROW(invalid_partition{});
+		}
+		lower = upper;
+	}
+}
+
+}
+
+template <typename T>
+class split_range;
+
+/** A random access iterator over the parts of a split_range<T>, which dereferences to an
+ *  interval<T>. The part is stored inside the iterator, so the reference returned from
+ *  operator*() is invalidated when the iterator is changed or destroyed. */
+template <typename T>
+class split_iterator {
+public:
+	typedef interval<T> value_type;
+	typedef typename direct_iterator<T>::difference_type difference_type;
+	typedef value_type const* pointer;
+	typedef value_type const& reference;
+	typedef std::random_access_iterator_tag iterator_category;
+
+	split_iterator() noexcept(std::is_nothrow_default_constructible<T>::value)
+	: m_range{nullptr}
+	, m_index{}
+	, m_part{T{}, T{}, false, false, detail::unchecked_tag{}} {
+	}
+
+	split_iterator(split_range<T> const& range, difference_type index)
+	: m_range{&range}
+	, m_index{index}
+	, m_part{range.whole()} {
+		update();
+	}
+
+	reference operator*() const noexcept {
+		return m_part;
+	}
+
+	pointer operator->() const noexcept {
+		return &m_part;
+	}
+
+	/** Returns the index of the part this iterator points to. */
+	difference_type index() const noexcept {
+		return m_index;
+	}
+
+	split_iterator<T>& operator++() {
+		++m_index;
+		update();
+		return *this;
+	}
+
+	split_iterator<T> operator++(int) {
+		auto const copy = *this;
+		++(*this);
+		return copy;
+	}
+
+	split_iterator<T>& operator--() {
+		--m_index;
+		update();
+		return *this;
+	}
+
+	split_iterator<T> operator--(int) {
+		auto const copy = *this;
+		--(*this);
+		return copy;
+	}
+
+	split_iterator<T>& operator+=(difference_type n) {
+		m_index += n;
+		update();
+		return *this;
+	}
+
+	split_iterator<T>& operator-=(difference_type n) {
+		m_index -= n;
+		update();
+		return *this;
+	}
+
+	split_iterator<T> operator-(difference_type n) const {
+		auto copy = *this;
+		copy -= n;
+		return copy;
+	}
+
+	value_type operator[](difference_type n) const {
+		return (*m_range)[m_index + n];
+	}
+
+private:
+	void update() {
+		if(m_index < m_range->size()) {
+			m_part = (*m_range)[m_index];
+		}
+	}
+
+	split_range<T> const* m_range;
+	difference_type m_index;
+	value_type m_part;
+};
+
+template <typename T>
+split_iterator<T> operator+(split_iterator<T> it, typename split_iterator<T>::difference_type n) {
+	it += n;
+	return it;
+}
+
+template <typename T>
+split_iterator<T> operator+(typename split_iterator<T>::difference_type n, split_iterator<T> it) {
+	it += n;
+	return it;
+}
+
+template <typename T>
+typename split_iterator<T>::difference_type operator-(split_iterator<T> const& lhs,
+                                                      split_iterator<T> const& rhs) noexcept {
+	return lhs.index() - rhs.index();
+}
+
+template <typename T>
+bool operator==(split_iterator<T> const& lhs, split_iterator<T> const& rhs) noexcept {
+	return lhs.index() == rhs.index();
+}
+
+template <typename T>
+bool operator!=(split_iterator<T> const& lhs, split_iterator<T> const& rhs) noexcept {
+	return lhs.index() != rhs.index();
+}
+
+template <typename T>
+bool operator<(split_iterator<T> const& lhs, split_iterator<T> const& rhs) noexcept {
+	return lhs.index() < rhs.index();
+}
+
+template <typename T>
+bool operator<=(split_iterator<T> const& lhs, split_iterator<T> const& rhs) noexcept {
+	return lhs.index() <= rhs.index();
+}
+
+template <typename T>
+bool operator>(split_iterator<T> const& lhs, split_iterator<T> const& rhs) noexcept {
+	return lhs.index() > rhs.index();
+}
+
+template <typename T>
+bool operator>=(split_iterator<T> const& lhs, split_iterator<T> const& rhs) noexcept {
+	return lhs.index() >= rhs.index();
+}
+
+/** A random access range of the size() contiguous, non-overlapping parts of an interval, which are
+ *  calculated on demand without allocating.
+ *
+ *  The first part has the same lower bound and left openness as the whole interval, and the last
+ *  part has the same upper bound and right openness. The seams between parts are closed on the
+ *  left and open on the right, so every value of the whole interval is contained by exactly one
+ *  part.
+ *
+ *  Iterators into a split_range refer to the range, so they must not outlive it. */
+template <typename T>
+class split_range {
+public:
+	typedef interval<T> value_type;
+	typedef split_iterator<T> iterator;
+	typedef iterator const_iterator;
+	typedef typename iterator::difference_type difference_type;
+
+	/** Splits \a whole into \a count parts. Throws invalid_partition if \a count is not positive,
+	 *  if \a whole has a countable type with fewer than \a count elements, or if \a whole has a
+	 *  floating point type and is too narrow to be split into \a count non-empty parts. */
+	split_range(interval<T> const& whole, difference_type count)
+	: m_whole{whole}
+	, m_size{count} {
+		static_assert(detail::splittable<T>::value,
+		              "split requires a countable or floating point underlying type");
+		typedef detail::is_countable<T> countable;
+		detail::check_part_count(m_whole, count, countable{});
+		difference_type i = 0;
+		detail::check_seams(m_whole, count, [&] {
+			return detail::equal_seam(m_whole, ++i, count, countable{});
+		}, countable{});
+	}
+
+	/** Returns the interval that was split. */
+	value_type const& whole() const noexcept {
+		return m_whole;
+	}
+
+	/** Returns the number of parts. */
+	difference_type size() const noexcept {
+		return m_size;
+	}
+
+	/** Returns the part at index \a i, which must be less than size(). */
+	value_type operator[](difference_type i) const {
+		typedef detail::is_countable<T> countable;
+		return detail::part(m_whole, i, m_size,
+		                    detail::equal_seam(m_whole, i, m_size, countable{}),
+		                    detail::equal_seam(m_whole, i + 1, m_size, countable{}));
+	}
+
+	value_type front() const {
+		return (*this)[0];
+	}
+
+	value_type back() const {
+		return (*this)[m_size - 1];
+	}
+
+	iterator begin() const {
+		return {*this, 0};
+	}
+
+	iterator end() const {
+		return {*this, m_size};
+	}
+
+	iterator cbegin() const {
+		return begin();
+	}
+
+	iterator cend() const {
+		return end();
+	}
+
+private:
+	value_type m_whole;
+	difference_type m_size;
+};
+
+/** Returns a range of \a n contiguous, non-overlapping parts of the interval \a r that together
+ *  contain exactly the same values as \a r.
+ *
+ *  For integral types, pointers and random access iterators, the number of elements in each part
+ *  differs by at most one, and for floating point types the parts have the same length. The outer
+ *  ends of the parts keep the openness of \a r, and the seams between the parts are closed on the
+ *  left and open on the right.
+ *
+ *  Throws invalid_partition if \a n is not positive, if \a r has fewer than \a n elements, or if
+ *  \a r has a floating point type and is too narrow to be split into \a n non-empty parts.
+ *
+ *  \code
+ *  for(auto part : ez::split(ez::make_interval(0)[10], 3)) {
+ *      std::cout << part << ' '; // prints (0, 5) [5, 8) [8, 10]
+ *  }
+ *  \endcode */
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+split_range<typename Interval::type> split(Interval const& r,
+                                           typename Interval::difference_type n) {
+	return {r, n};
+}
+
+/** Writes one contiguous, non-overlapping part of the interval \a r to \a out for every weight in
+ *  [\a first, \a last), where the size of each part is proportional to its weight. The parts
+ *  together contain exactly the same values as \a r. Returns the output iterator one past the last
+ *  part written.
+ *
+ *  For integral types, pointers and random access iterators, the elements are shared out in
+ *  proportion to the weights, rounded to the nearest element, and every part has at least one
+ *  element. For floating point
+ *  types the length of each part is proportional to its weight. The outer ends of the parts keep
+ *  the openness of \a r, and the seams between the parts are closed on the left and open on the
+ *  right.
+ *
+ *  Throws invalid_partition if there are no weights, if a weight is not positive, if \a r has
+ *  fewer elements than there are weights, or if \a r has a floating point type and is too narrow
+ *  for every part to be non-empty. Nothing is written to \a out when this is thrown.
+ *
+ *  \code
+ *  std::vector<int> weights = {1, 2, 1};
+ *  std::vector<ez::interval<int>> parts;
+ *  ez::split_weighted(ez::make_interval[0](12), weights.begin(), weights.end(),
+ *                     std::back_inserter(parts)); // [0, 3), [3, 9), [9, 12)
+ *  \endcode */
+template <typename Interval, typename ForwardIterator, typename OutputIterator,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+OutputIterator split_weighted(Interval const& r, ForwardIterator first, ForwardIterator last,
+                              OutputIterator out) {
+	typedef typename Interval::type T;
+	typedef typename Interval::difference_type difference_type;
+	typedef typename std::iterator_traits<ForwardIterator>::value_type weight_type;
+	typedef detail::is_countable<T> countable;
+	static_assert(detail::splittable<T>::value,
+	              "split_weighted requires a countable or floating point underlying type");
+
+	interval<T> const whole{r};
+	auto total = weight_type{0};
+	for(auto it = first; it != last; ++it) {
+		if(!(*it > weight_type{0})) {
+			EZ_THROW(invalid_partition{});
+		}
+		total += *it;
+	}
+
+	auto const count = static_cast<difference_type>(std::distance(first, last));
+	detail::check_part_count(whole, count, countable{});
+	{
+		auto it = first;
+		auto before = weight_type{0};
+		difference_type i = 0;
+		difference_type offset = 0;
+		detail::check_seams(whole, count, [&] {
+			before += *it++;
+			return detail::weighted_seam(whole, ++i, count, before, total, offset, countable{});
+		}, countable{});
+	}
+
+	auto before = weight_type{0};
+	auto lower = whole.lower();
+	difference_type offset = 0;
+	for(difference_type i = 0; first != last; ++first, ++i) {
+		before += *first;
+		auto const upper = detail::weighted_seam(whole, i + 1, count, before, total, offset,
+		                                         countable{});
+		*out = detail::part(whole, i, count, lower, upper);
+		++out;
+		lower = upper;
+	}
+
+	return out;
+}
+
+/** Calls ez::split_weighted with all of the weights in the container \a weights. */
+template <typename Interval, typename Weights, typename OutputIterator,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+OutputIterator split_weighted(Interval const& r, Weights const& weights, OutputIterator out) {
+	return split_weighted(r, std::begin(weights), std::end(weights), std::move(out));
+}
+
+}
+
+#endif
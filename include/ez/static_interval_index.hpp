@@ -0,0 +1,230 @@
+/******************************************************************//**
+ * \file   static_interval_index.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_D89F613E_DE82_43B6_9A2E_9BA9CBF53618
+#define INCLUDE_GUARD_D89F613E_DE82_43B6_9A2E_9BA9CBF53618
+
+#include "ez/interval.hpp"
+#include "ez/interval_set.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <numeric>
+#include <vector>
+
+namespace ez {
+
+namespace detail {
+
+inline void prefetch(void const* p) noexcept {
+#if defined(__GNUC__)
+	__builtin_prefetch(p);
+#else
+	static_cast<void>(p);
+#endif
+}
+
+// Returns k with its trailing zeros and the last one bit removed. In an Eytzinger tree this is
+// the last node where the search for k went right.
+inline std::size_t last_right_turn(std::size_t k) noexcept {
+#if defined(__GNUC__)
+	return k >> (__builtin_ctzll(k) + 1);
+#else
+	while(k % 2 == 0) {
+		k /= 2;
+	}
+	return k / 2;
+#endif
+}
+
+}
+
+/** An immutable set of intervals that finds all intervals containing a value, or overlapping an
+ *  interval.
+ *
+ *  The intervals are sorted by lower bound and stored in Eytzinger order, which is the order of a
+ *  breadth-first walk of a complete binary search tree, so the children of node k are nodes 2k
+ *  and 2k + 1. The first levels of the tree share a few cache lines, and a search
+ *  fetches the nodes it will need a few levels ahead without branching on the comparisons. Each
+ *  node also stores the largest upper bound of its subtree, so overlap queries skip subtrees that
+ *  end before the query.
+ *
+ *  Queries report the position of each interval in the range it was built from, in order of lower
+ *  bound, by writing them to an output iterator such as a pointer into a caller's buffer.
+ *
+ *  \code
+ *  ez::static_interval_index<int> index = {ez::make_interval[0](10), ez::make_interval(5)[20]};
+ *  assert(index.contains(7));
+ *  std::size_t found[2];
+ *  auto const end = index.containing(7, found); // found = {0, 1}, end = found + 2
+ *  \endcode */
+template <typename T>
+class static_interval_index {
+public:
+	typedef T type;
+	typedef interval<T> value_type;
+	typedef std::size_t size_type;
+
+	static_interval_index() = default;
+
+	template <typename ForwardIterator>
+	static_interval_index(ForwardIterator first, ForwardIterator last) {
+		std::vector<interval<T>> const input(first, last);
+		std::vector<std::size_t> order(input.size());
+		std::iota(order.begin(), order.end(), std::size_t{0});
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+			return detail::lower_cut(input[a]) < detail::lower_cut(input[b]);
+		});
+
+		// sorted[k - 1] is the position in order of node k
+		auto const n = input.size();
+		std::vector<std::size_t> sorted(n);
+		std::size_t i = 0;
+		eytzinger(1, sorted, i);
+
+		m_intervals.reserve(n);
+		m_ids.reserve(n);
+		for(auto const s : sorted) {
+			m_intervals.push_back(input[order[s]]);
+			m_ids.push_back(order[s]);
+		}
+
+		std::vector<detail::cut<T>> prefix;
+		prefix.reserve(n);
+		for(auto const id : order) {
+			auto const upper = detail::upper_cut(input[id]);
+			prefix.push_back((prefix.empty() || prefix.back() < upper) ? upper : prefix.back());
+		}
+		m_prefix_max.reserve(n);
+		for(auto const s : sorted) {
+			m_prefix_max.push_back(prefix[s]);
+		}
+
+		// Children are after their parents so a reverse sweep sees them first
+		m_subtree_max.resize(n);
+		for(auto k = n; k >= 1; --k) {
+			auto upper = detail::upper_cut(m_intervals[k - 1]);
+			for(auto const child : {2 * k, 2 * k + 1}) {
+				if(child <= n && upper < m_subtree_max[child - 1]) {
+					upper = m_subtree_max[child - 1];
+				}
+			}
+			m_subtree_max[k - 1] = upper;
+		}
+	}
+
+	static_interval_index(std::initializer_list<interval<T>> list)
+	: static_interval_index(list.begin(), list.end()) {
+	}
+
+	size_type size() const {
+		return m_ids.size();
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	/** Returns whether any interval contains \a x in O(log n), without branching on the
+	 *  intervals. */
+	bool contains(T const& x) const {
+		// The intervals before the last one whose lower bound is at most x are exactly those
+		// which start at or before x, so one of them contains x if their largest upper bound
+		// is after x
+		detail::cut<T> const point{x, false};
+		auto const j = predecessor(point);
+		return j != 0 && point < m_prefix_max[j - 1];
+	}
+
+	/** Writes the position of every interval containing \a x to \a out and returns the end of
+	 *  the output. */
+	template <typename OutputIterator>
+	OutputIterator containing(T const& x, OutputIterator out) const {
+		return visit(1, detail::cut<T>{x, false}, detail::cut<T>{x, true}, out);
+	}
+
+	/** Writes the position of every interval that has at least one value in common with
+	 *  \a query to \a out and returns the end of the output. */
+	template <typename OutputIterator>
+	OutputIterator overlapping(interval<T> const& query, OutputIterator out) const {
+		return visit(1, detail::lower_cut(query), detail::upper_cut(query), out);
+	}
+
+private:
+	// Numbers the nodes of the subtree at k in order, starting from i
+	void eytzinger(std::size_t k, std::vector<std::size_t>& sorted, std::size_t& i) {
+		if(k > sorted.size()) {
+			return;
+		}
+
+		eytzinger(2 * k, sorted, i);
+		sorted[k - 1] = i++;
+		eytzinger(2 * k + 1, sorted, i);
+	}
+
+	// Returns the position of the last interval whose lower bound is at most point, or 0
+	std::size_t predecessor(detail::cut<T> const& point) const {
+		// The 16 nodes four levels below k are next to each other, so start fetching them
+		auto const n = size();
+		std::size_t k = 1;
+		while(k <= n) {
+			detail::prefetch(m_intervals.data() + (std::min(16 * k, n) - 1));
+			k = 2 * k + (detail::lower_cut(m_intervals[k - 1]) <= point);
+		}
+		return detail::last_right_turn(k);
+	}
+
+	template <typename OutputIterator>
+	OutputIterator visit(std::size_t k, detail::cut<T> const& lower, detail::cut<T> const& upper,
+	                     OutputIterator out) const {
+		auto const n = size();
+		while(k <= n && lower < m_subtree_max[k - 1]) {
+			out = visit(2 * k, lower, upper, out);
+			if(upper <= detail::lower_cut(m_intervals[k - 1])) {
+				break;
+			}
+
+			if(lower < detail::upper_cut(m_intervals[k - 1])) {
+				*out++ = m_ids[k - 1];
+			}
+			k = 2 * k + 1;
+		}
+		return out;
+	}
+
+	std::vector<interval<T>> m_intervals;
+	std::vector<detail::cut<T>> m_subtree_max;
+	std::vector<detail::cut<T>> m_prefix_max;
+	std::vector<std::size_t> m_ids;
+};
+
+}
+
+#endif
@@ -0,0 +1,161 @@
+/******************************************************************//**
+ * \file   static_partition.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_B4072C56_6A8A_4BE4_8074_1A1FF1BB0736
+#define INCLUDE_GUARD_B4072C56_6A8A_4BE4_8074_1A1FF1BB0736
+
+#include "ez/interval.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ez {
+
+namespace detail {
+
+template <std::size_t I, typename T, T... Values>
+struct nth_value;
+
+template <typename T, T First, T... Rest>
+struct nth_value<0, T, First, Rest...> : std::integral_constant<T, First> {
+};
+
+template <std::size_t I, typename T, T First, T... Rest>
+struct nth_value<I, T, First, Rest...> : nth_value<I - 1, T, Rest...> {
+};
+
+template <typename T, T... Values>
+struct strictly_increasing : std::true_type {
+};
+
+template <typename T, T First, T Second, T... Rest>
+struct strictly_increasing<T, First, Second, Rest...>
+	: std::integral_constant<bool, (First < Second) &&
+	                               strictly_increasing<T, Second, Rest...>::value> {
+};
+
+// partition_search is a balanced tree of comparisons between a value and the bounds with
+// positions in [Lo, Hi), where each leaf is the number of bounds that are at most the value. A
+// count of 0 or Size + 1 is outside the partition, which maps to the bucket Size.
+template <typename T, std::size_t Lo, std::size_t Hi, std::size_t Size, T... Bounds>
+struct partition_search {
+	static std::size_t const mid = Lo + (Hi - Lo) / 2;
+	typedef partition_search<T, Lo, mid, Size, Bounds...> below;
+	typedef partition_search<T, mid + 1, Hi, Size, Bounds...> above;
+
+	static constexpr std::size_t find(T value) {
+		return (value < nth_value<mid, T, Bounds...>::value) ? below::find(value)
+		                                                     : above::find(value);
+	}
+
+	template <typename Result, typename Function>
+	static Result dispatch(T value, Function& f) {
+		return (value < nth_value<mid, T, Bounds...>::value)
+		  ? below::template dispatch<Result>(value, f)
+		  : above::template dispatch<Result>(value, f);
+	}
+};
+
+template <typename T, std::size_t Count, std::size_t Size, T... Bounds>
+struct partition_search<T, Count, Count, Size, Bounds...> {
+	typedef std::integral_constant<std::size_t, (Count >= 1 && Count <= Size) ? Count - 1 : Size>
+	  bucket;
+
+	static constexpr std::size_t find(T) {
+		return bucket::value;
+	}
+
+	template <typename Result, typename Function>
+	static Result dispatch(T, Function& f) {
+		return f(bucket{});
+	}
+};
+
+}
+
+/** A partition of values of T into the intervals [Bounds_0, Bounds_1), [Bounds_1, Bounds_2), ...
+ *  that is fixed at compile time.
+ *
+ *  The bounds must be strictly increasing, which is checked with a static_assert. find() is a
+ *  balanced tree of comparisons against constants that is generated at compile time, and it can
+ *  be used in constant expressions. dispatch() uses the same tree to call a function with the
+ *  bucket as a std::integral_constant, so each bucket can be handled by its own code.
+ *
+ *  \code
+ *  typedef ez::static_partition<int, 100, 200, 300, 400, 500, 600> status_classes;
+ *  static_assert(status_classes::find(404) == 3, "client error");
+ *  static_assert(status_classes::find(99) == status_classes::size(), "not a status");
+ *  static_assert(status_classes::interval(1).lower() == 200, "success");
+ *  \endcode */
+template <typename T, T... Bounds>
+class static_partition {
+	static_assert(sizeof...(Bounds) >= 1, "A partition needs at least one bound");
+	static_assert(detail::strictly_increasing<T, Bounds...>::value,
+	              "The bounds of a partition must be strictly increasing");
+
+	typedef detail::partition_search<T, 0, sizeof...(Bounds), sizeof...(Bounds) - 1, Bounds...>
+	  search;
+
+public:
+	typedef T type;
+	typedef ropen_interval<T> value_type;
+
+	/** Returns the number of intervals. */
+	static constexpr std::size_t size() {
+		return sizeof...(Bounds) - 1;
+	}
+
+	/** Returns the i-th interval. */
+	static constexpr ropen_interval<T> interval(std::size_t i) {
+		return ropen_interval<T>{bounds[i], bounds[i + 1]};
+	}
+
+	/** Returns the position of the interval containing \a value, or size() if there is none. */
+	static constexpr std::size_t find(T value) {
+		return search::find(value);
+	}
+
+	/** Returns \a f(std::integral_constant<std::size_t, find(value)>{}). */
+	template <typename Function>
+	static auto dispatch(T value, Function f)
+	  -> decltype(f(std::integral_constant<std::size_t, 0>{})) {
+		typedef decltype(f(std::integral_constant<std::size_t, 0>{})) result;
+		return search::template dispatch<result>(value, f);
+	}
+
+private:
+	static constexpr T bounds[] = {Bounds...};
+};
+
+template <typename T, T... Bounds>
+constexpr T static_partition<T, Bounds...>::bounds[];
+
+}
+
+#endif
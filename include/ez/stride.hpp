@@ -0,0 +1,319 @@
+/******************************************************************//**
+ * \file   stride.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_A1549CE2_FC99_494B_8D07_060FD80D0249
+#define INCLUDE_GUARD_A1549CE2_FC99_494B_8D07_060FD80D0249
+
+#include "ez/direct_iterator.hpp"
+#include "ez/interval.hpp"
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ez {
+
+/** An invalid_stride exception is thrown when trying to stride through an interval with a step
+ *  that is not positive. */
+struct invalid_stride : std::runtime_error {
+	invalid_stride()
+	: std::runtime_error{"Stride must be positive"} {
+	}
+};
+
+/** A random access iterator over an integral type T that advances by a fixed step each time it is
+ *  incremented. The step may be negative to iterate backwards.
+ *
+ *  Like counted_iterator<T>, two strided_iterators are compared using only the number of steps
+ *  they have taken, and the arithmetic on the underlying value wraps around rather than
+ *  overflowing, so the end iterator of a strided_range is always valid. */
+template <typename T>
+class strided_iterator {
+	static_assert(detail::is_wrapping<T>::value,
+	              "strided_iterator can only be used with integral types");
+
+public:
+	typedef T value_type;
+	typedef typename direct_iterator<T>::difference_type difference_type;
+	typedef T const* pointer;
+	typedef T const& reference;
+	typedef typename direct_iterator<T>::iterator_category iterator_category;
+
+	strided_iterator() noexcept
+	: m_value{}
+	, m_count{}
+	, m_step{1} {
+	}
+
+	strided_iterator(T const& value, difference_type count, difference_type step) noexcept
+	: m_value{value}
+	, m_count{count}
+	, m_step{step} {
+	}
+
+	reference operator*() const noexcept {
+		return m_value;
+	}
+
+	pointer operator->() const noexcept {
+		return &m_value;
+	}
+
+	/** Returns the number of steps this iterator has taken from the start of its range. */
+	difference_type count() const noexcept {
+		return m_count;
+	}
+
+	/** Returns the amount the underlying value changes with each increment. */
+	difference_type step() const noexcept {
+		return m_step;
+	}
+
+	strided_iterator<T>& operator++() noexcept {
+		detail::wrapping_advance(m_value, m_step, std::true_type{});
+		++m_count;
+		return *this;
+	}
+
+	strided_iterator<T> operator++(int) noexcept {
+		auto const copy = *this;
+		++(*this);
+		return copy;
+	}
+
+	strided_iterator<T>& operator--() noexcept {
+		detail::wrapping_advance(m_value, -m_step, std::true_type{});
+		--m_count;
+		return *this;
+	}
+
+	strided_iterator<T> operator--(int) noexcept {
+		auto const copy = *this;
+		--(*this);
+		return copy;
+	}
+
+	strided_iterator<T>& operator+=(difference_type n) noexcept {
+		detail::wrapping_advance(m_value, n * m_step, std::true_type{});
+		m_count += n;
+		return *this;
+	}
+
+	strided_iterator<T>& operator-=(difference_type n) noexcept {
+		detail::wrapping_advance(m_value, -n * m_step, std::true_type{});
+		m_count -= n;
+		return *this;
+	}
+
+	strided_iterator<T> operator-(difference_type n) const noexcept {
+		auto copy = *this;
+		copy -= n;
+		return copy;
+	}
+
+	T operator[](difference_type n) const noexcept {
+		auto copy = m_value;
+		detail::wrapping_advance(copy, n * m_step, std::true_type{});
+		return copy;
+	}
+
+private:
+	T m_value;
+	difference_type m_count;
+	difference_type m_step;
+};
+
+template <typename T>
+strided_iterator<T> operator+(strided_iterator<T> it,
+                              typename strided_iterator<T>::difference_type n) noexcept {
+	it += n;
+	return it;
+}
+
+template <typename T>
+strided_iterator<T> operator+(typename strided_iterator<T>::difference_type n,
+                              strided_iterator<T> it) noexcept {
+	it += n;
+	return it;
+}
+
+template <typename T>
+typename strided_iterator<T>::difference_type
+  operator-(strided_iterator<T> const& lhs, strided_iterator<T> const& rhs) noexcept {
+	return lhs.count() - rhs.count();
+}
+
+template <typename T>
+bool operator==(strided_iterator<T> const& lhs, strided_iterator<T> const& rhs) noexcept {
+	return lhs.count() == rhs.count();
+}
+
+template <typename T>
+bool operator!=(strided_iterator<T> const& lhs, strided_iterator<T> const& rhs) noexcept {
+	return lhs.count() != rhs.count();
+}
+
+template <typename T>
+bool operator<(strided_iterator<T> const& lhs, strided_iterator<T> const& rhs) noexcept {
+	return lhs.count() < rhs.count();
+}
+
+template <typename T>
+bool operator<=(strided_iterator<T> const& lhs, strided_iterator<T> const& rhs) noexcept {
+	return lhs.count() <= rhs.count();
+}
+
+template <typename T>
+bool operator>(strided_iterator<T> const& lhs, strided_iterator<T> const& rhs) noexcept {
+	return lhs.count() > rhs.count();
+}
+
+template <typename T>
+bool operator>=(strided_iterator<T> const& lhs, strided_iterator<T> const& rhs) noexcept {
+	return lhs.count() >= rhs.count();
+}
+
+/** A range of size() values of an integral type T, starting at front() and separated by step().
+ *
+ *  The number of elements is calculated when the range is created, so iterating through a
+ *  strided_range is a counted loop with the same cost as a hand-written strided loop. */
+template <typename T>
+class strided_range {
+public:
+	typedef T type;
+	typedef strided_iterator<T> iterator;
+	typedef iterator const_iterator;
+	typedef typename iterator::difference_type difference_type;
+
+	strided_range(T const& first, difference_type size, difference_type step) noexcept
+	: m_first{first}
+	, m_size{size}
+	, m_step{step} {
+	}
+
+	/** Returns the first value of this range. This must not be called on an empty range. */
+	T const& front() const noexcept {
+		return m_first;
+	}
+
+	/** Returns the last value of this range. This must not be called on an empty range. */
+	T back() const noexcept {
+		return begin()[m_size - 1];
+	}
+
+	difference_type size() const noexcept {
+		return m_size;
+	}
+
+	bool empty() const noexcept {
+		return m_size == 0;
+	}
+
+	difference_type step() const noexcept {
+		return m_step;
+	}
+
+	iterator begin() const noexcept {
+		return {m_first, 0, m_step};
+	}
+
+	iterator end() const noexcept {
+		return begin() + m_size;
+	}
+
+	iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	iterator cend() const noexcept {
+		return end();
+	}
+
+private:
+	T m_first;
+	difference_type m_size;
+	difference_type m_step;
+};
+
+/** Returns a range containing every \a step-th element of the interval \a r, starting with the
+ *  smallest element in \a r. Throws invalid_stride if \a step is not positive.
+ *
+ *  \code
+ *  for(auto i : ez::stride(ez::make_interval[0](10), 4)) {
+ *      std::cout << i << ' '; // prints 0 4 8
+ *  }
+ *  \endcode */
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+strided_range<typename Interval::type> stride(Interval const& r,
+                                              typename Interval::difference_type step) {
+	if(step <= 0) {
+		EZ_THROW(invalid_stride{});
+	}
+
+	auto const size = r.size();
+	return {*r.begin(), size == 0 ? 0 : (size - 1) / step + 1, step};
+}
+
+/** Returns a range containing every \a step-th element of \a r. Throws invalid_stride if \a step
+ *  is not positive. */
+template <typename T>
+strided_range<T> stride(strided_range<T> const& r,
+                        typename strided_range<T>::difference_type step) {
+	if(step <= 0) {
+		EZ_THROW(invalid_stride{});
+	}
+
+	auto const size = r.size();
+	return {r.front(), size == 0 ? 0 : (size - 1) / step + 1, r.step() * step};
+}
+
+/** Returns a range containing the elements of the interval \a r in decreasing order.
+ *
+ *  \code
+ *  for(auto i : ez::reversed(ez::make_interval(0)[3])) {
+ *      std::cout << i << ' '; // prints 3 2 1
+ *  }
+ *  \endcode */
+template <typename Interval,
+          typename std::enable_if<is_interval<Interval>::value>::type* = nullptr>
+strided_range<typename Interval::type> reversed(Interval const& r) {
+	auto const size = r.size();
+	return {size == 0 ? *r.begin() : r.begin()[size - 1], size, -1};
+}
+
+/** Returns a range containing the elements of \a r in reverse order. */
+template <typename T>
+strided_range<T> reversed(strided_range<T> const& r) noexcept {
+	return {r.empty() ? r.front() : r.back(), r.size(), -r.step()};
+}
+
+}
+
+#endif
@@ -0,0 +1,323 @@
+/******************************************************************//**
+ * \file   thread_pool.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_7B5594B5_5D98_45A8_BDC6_AA003D0BF050
+#define INCLUDE_GUARD_7B5594B5_5D98_45A8_BDC6_AA003D0BF050
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ez {
+
+class thread_pool;
+
+namespace detail {
+
+// worker_identity records which thread_pool, if any, the current thread is a worker of
+struct worker_identity {
+	thread_pool const* pool;
+	std::size_t index;
+};
+
+inline worker_identity& this_worker() {
+	static thread_local worker_identity identity = {nullptr, 0};
+	return identity;
+}
+
+}
+
+/** A pool of threads that run tasks using work stealing.
+ *
+ *  Each worker thread has its own queue of tasks. Tasks pushed from a worker go onto the back of
+ *  its own queue and are taken from the back again, so recursively split work stays local to the
+ *  thread that created it. Workers that run out of tasks steal from the front of the other queues,
+ *  which holds the largest pieces of work. Tasks pushed from threads outside of the pool go into a
+ *  shared queue.
+ *
+ *  Tasks should not throw. Use task_group to run tasks that may throw and to wait for them. */
+class thread_pool {
+public:
+	typedef std::function<void()> task;
+
+	/** Creates a pool with \a threads worker threads. A pool with no threads is valid, in which case
+	 *  all tasks are run by threads waiting in task_group::wait(). */
+	explicit thread_pool(std::size_t threads = default_size())
+	: m_queues(threads + 1)
+	, m_queued{0}
+	, m_stop{false} {
+		for(auto& queue : m_queues) {
+			queue.reset(new task_queue{});
+		}
+
+		m_threads.reserve(threads);
+		for(std::size_t i = 0; i < threads; ++i) {
+			m_threads.emplace_back([this, i]{ work(i); });
+		}
+	}
+
+	thread_pool(thread_pool const&) = delete;
+	thread_pool& operator=(thread_pool const&) = delete;
+
+	/** Stops and joins all worker threads. Tasks that have not started are discarded. */
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_stop = true;
+		}
+		m_condition.notify_all();
+
+		for(auto& thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	/** Returns the number of worker threads. */
+	std::size_t size() const noexcept {
+		return m_threads.size();
+	}
+
+	/** Returns the number of worker threads used by default, which is one less than the number of
+	 *  hardware threads as the thread that waits for the work also runs tasks. */
+	static std::size_t default_size() noexcept {
+		auto const hardware = std::thread::hardware_concurrency();
+		return hardware > 1 ? hardware - 1 : 0;
+	}
+
+	/** Adds \a t to the queue of the current thread. */
+	void push(task t) {
+		auto& queue = *m_queues[own_queue()];
+		{
+			std::lock_guard<std::mutex> lock{queue.mutex};
+			queue.tasks.push_back(std::move(t));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			++m_queued;
+		}
+		m_condition.notify_one();
+	}
+
+	/** Runs one queued task, if there is one, and returns whether a task was run. The task is taken
+	 *  from the back of the current thread's queue, or stolen from the front of another queue. */
+	bool try_run_one() {
+		task t;
+		if(!pop(t)) {
+			return false;
+		}
+
+		t();
+		return true;
+	}
+
+private:
+	struct task_queue {
+		std::mutex mutex;
+		std::deque<task> tasks;
+	};
+
+	std::size_t own_queue() const noexcept {
+		auto const& identity = detail::this_worker();
+		return identity.pool == this ? identity.index : m_queues.size() - 1;
+	}
+
+	bool pop(task& t) {
+		auto const self = own_queue();
+		{
+			auto& queue = *m_queues[self];
+			std::lock_guard<std::mutex> lock{queue.mutex};
+			if(!queue.tasks.empty()) {
+				t = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				--m_queued;
+				return true;
+			}
+		}
+
+		for(std::size_t i = 1; i < m_queues.size(); ++i) {
+			auto& queue = *m_queues[(self + i) % m_queues.size()];
+			std::lock_guard<std::mutex> lock{queue.mutex};
+			if(!queue.tasks.empty()) {
+				t = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				--m_queued;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void work(std::size_t index) {
+		detail::this_worker() = detail::worker_identity{this, index};
+		for(;;) {
+			if(try_run_one()) {
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock{m_mutex};
+			m_condition.wait(lock, [this]{ return m_stop || m_queued.load() != 0; });
+			if(m_stop) {
+				return;
+			}
+		}
+	}
+
+	std::vector<std::unique_ptr<task_queue>> m_queues;
+	std::vector<std::thread> m_threads;
+	std::atomic<std::size_t> m_queued;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stop;
+};
+
+/** Returns a thread_pool with thread_pool::default_size() threads that is shared by the whole
+ *  program. */
+inline thread_pool& default_thread_pool() {
+	static thread_pool pool;
+	return pool;
+}
+
+/** A set of tasks run on a thread_pool that can be waited for together.
+ *
+ *  If a task throws, the remaining tasks in the group that have not started are skipped and the
+ *  first exception is rethrown from wait().
+ *
+ *  \code
+ *  ez::task_group group{ez::default_thread_pool()};
+ *  group.run([]{ do_something(); });
+ *  group.run([]{ do_something_else(); });
+ *  group.wait();
+ *  \endcode */
+class task_group {
+public:
+	explicit task_group(thread_pool& pool) noexcept
+	: m_pool(pool)
+	, m_pending{0}
+	, m_cancelled{false} {
+	}
+
+	task_group(task_group const&) = delete;
+	task_group& operator=(task_group const&) = delete;
+
+	/** Waits for all tasks, ignoring any exceptions, as the tasks may refer to this group. */
+	~task_group() {
+		join();
+	}
+
+	thread_pool& pool() const noexcept {
+		return m_pool;
+	}
+
+	/** Queues \a f to be run on the thread pool. */
+	template <typename Function>
+	void run(Function f) {
+		++m_pending;
+#ifdef EZ_NO_EXCEPTIONS
+		m_pool.push([this, f]{
+			if(!m_cancelled.load(std::memory_order_relaxed)) {
+				f();
+			}
+			--m_pending;
+		});
+#else
+		try {
+			m_pool.push([this, f]{
+				if(!m_cancelled.load(std::memory_order_relaxed)) {
+					try {
+						f();
+					} catch(...) {
+						cancel(std::current_exception());
+					}
+				}
+				--m_pending;
+			});
+		} catch(...) {
+			--m_pending;
+			throw;
+		}
+#endif
+	}
+
+	/** Runs queued tasks until all tasks in this group have finished, then rethrows the first
+	 *  exception thrown by a task, if any. */
+	void wait() {
+		join();
+		if(m_exception) {
+			auto const exception = m_exception;
+			m_exception = nullptr;
+			m_cancelled = false;
+			std::rethrow_exception(exception);
+		}
+	}
+
+	/** Returns true if a task has thrown or cancel() has been called since the last wait(). */
+	bool cancelled() const noexcept {
+		return m_cancelled.load();
+	}
+
+	/** Skips any tasks that have not started and makes wait() rethrow \a exception, unless another
+	 *  task has already thrown. */
+	void cancel(std::exception_ptr exception) {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		if(!m_exception) {
+			m_exception = exception;
+		}
+		m_cancelled = true;
+	}
+
+private:
+	void join() noexcept {
+		while(m_pending.load() != 0) {
+			if(!m_pool.try_run_one()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	thread_pool& m_pool;
+	std::atomic<std::size_t> m_pending;
+	std::atomic<bool> m_cancelled;
+	std::mutex m_mutex;
+	std::exception_ptr m_exception;
+};
+
+}
+
+#endif
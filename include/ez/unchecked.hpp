@@ -0,0 +1,128 @@
+/******************************************************************//**
+ * \file   unchecked.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_36A01ED6_79A6_40ED_939A_5ABF1A9A65D9
+#define INCLUDE_GUARD_36A01ED6_79A6_40ED_939A_5ABF1A9A65D9
+
+#include "ez/interval.hpp"
+
+#include <cassert>
+#include <type_traits>
+
+namespace ez {
+
+/***************************************************************************************************
+* Arithmetic for basic_interval without validation                                                 *
+***************************************************************************************************/
+
+/* These give the same results as the arithmetic operators for basic_interval, but do not check that
+   the result is non-empty, or that a divisor does not contain zero, except with assert(). They are
+   for inner loops where these are already known, and compile to the same instructions as the
+   arithmetic on a std::pair of bounds when NDEBUG is defined.
+
+   \code
+   auto total = ez::closed_interval<double>{0.0, 0.0};
+   for(auto const& r : measurements) {
+       total = ez::unchecked_add(total, r);
+   }
+   \endcode */
+
+template <typename T, bool LOpen, bool ROpen>
+constexpr basic_interval<T, LOpen, ROpen>
+  unchecked_add(basic_interval<T, LOpen, ROpen> const& l, basic_interval<T, LOpen, ROpen> const& r)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	return {l.lower() + r.lower(), l.upper() + r.upper(), unchecked};
+}
+
+template <typename T, bool LOpen, bool ROpen>
+constexpr basic_interval<T, LOpen, ROpen>
+  unchecked_add(basic_interval<T, LOpen, ROpen> const& l,
+                typename basic_interval<T, LOpen, ROpen>::difference_type const& d)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	return basic_interval<T, LOpen, ROpen>(l.lower() + d, l.upper() + d, unchecked);
+}
+
+template <typename T, bool LOpen, bool ROpen>
+constexpr basic_interval<T, LOpen, ROpen>
+  unchecked_sub(basic_interval<T, LOpen, ROpen> const& l, basic_interval<T, ROpen, LOpen> const& r)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	return {l.lower() - r.upper(), l.upper() - r.lower(), unchecked};
+}
+
+template <typename T, bool LOpen, bool ROpen>
+constexpr basic_interval<T, LOpen, ROpen>
+  unchecked_sub(basic_interval<T, LOpen, ROpen> const& l,
+                typename basic_interval<T, LOpen, ROpen>::difference_type const& d)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	return basic_interval<T, LOpen, ROpen>(l.lower() - d, l.upper() - d, unchecked);
+}
+
+template <typename T, bool Open>
+EZ_CONSTEXPR14 basic_interval<T, Open, Open>
+  unchecked_mul(basic_interval<T, Open, Open> const& l, basic_interval<T, Open, Open> const& r)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	auto const result = detail::minmax4(l.lower() * r.lower(), l.lower() * r.upper(),
+	                                    l.upper() * r.lower(), l.upper() * r.upper());
+	return {result.first, result.second, unchecked};
+}
+
+/** Multiplies both bounds by \a d, which must not be negative unless the interval is a
+ *  singleton. */
+template <typename T, bool LOpen, bool ROpen>
+constexpr basic_interval<T, LOpen, ROpen>
+  unchecked_mul(basic_interval<T, LOpen, ROpen> const& l,
+                typename basic_interval<T, LOpen, ROpen>::type const& d)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	return {l.lower() * d, l.upper() * d, unchecked};
+}
+
+/** Divides \a l by \a r, which must not contain zero. */
+template <typename T, bool Open>
+EZ_CONSTEXPR14 basic_interval<T, Open, Open>
+  unchecked_div(basic_interval<T, Open, Open> const& l, basic_interval<T, Open, Open> const& r)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	assert(!contains(r, T{0}));
+	auto const result = detail::minmax4(l.lower() / r.lower(), l.lower() / r.upper(),
+	                                    l.upper() / r.lower(), l.upper() / r.upper());
+	return {result.first, result.second, unchecked};
+}
+
+/** Divides both bounds by \a d, which must be positive unless the interval is a singleton. */
+template <typename T, bool LOpen, bool ROpen>
+EZ_CONSTEXPR14 basic_interval<T, LOpen, ROpen>
+  unchecked_div(basic_interval<T, LOpen, ROpen> const& l,
+                typename basic_interval<T, LOpen, ROpen>::type const& d)
+  noexcept(std::is_nothrow_copy_constructible<T>::value) {
+	assert(d != T{0});
+	return {l.lower() / d, l.upper() / d, unchecked};
+}
+
+}
+
+#endif
@@ -4,6 +4,10 @@
 #include <boost/test/unit_test.hpp>
 
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(basic_interval)
 
@@ -68,6 +72,57 @@ BOOST_AUTO_TEST_CASE(BeginEndTest) {
 	BOOST_CHECK_EQUAL(*B.cend(), 4);
 }
 
+BOOST_AUTO_TEST_CASE(Size) {
+	BOOST_CHECK_EQUAL(ez::make_interval[0][4].size(), 5);
+	BOOST_CHECK_EQUAL(ez::make_interval[0](4).size(), 4);
+	BOOST_CHECK_EQUAL(ez::make_interval(0)[4].size(), 4);
+	BOOST_CHECK_EQUAL(ez::make_interval(0)(4).size(), 3);
+	BOOST_CHECK_EQUAL(ez::make_interval(0)(1).size(), 0);
+	BOOST_CHECK_EQUAL(ez::make_interval[-3][-3].size(), 1);
+
+	auto const max = std::numeric_limits<int>::max();
+	auto const min = std::numeric_limits<int>::min();
+	BOOST_CHECK_EQUAL(ez::make_interval[min][max].size(), std::ptrdiff_t{1} << 32);
+	BOOST_CHECK_EQUAL(ez::make_interval[0u][std::numeric_limits<unsigned>::max()].size(),
+	                  std::ptrdiff_t{1} << 32);
+
+	std::vector<int> vec = {1, 2, 3};
+	BOOST_CHECK_EQUAL(ez::iterate(vec).size(), 3);
+	BOOST_CHECK_EQUAL(ez::indices(vec).size(), 3);
+
+	auto const A = ez::make_interval[-2](5);
+	BOOST_CHECK_EQUAL(A.end() - A.begin(), A.size());
+	BOOST_CHECK_EQUAL(std::distance(A.begin(), A.end()), A.size());
+}
+
+BOOST_AUTO_TEST_CASE(IterateToMax) {
+	typedef ez::counted_iterator<int> iterator;
+	static_assert(std::is_same<ez::closed_interval<int>::iterator, iterator>::value, "");
+	static_assert(std::is_same<ez::closed_interval<double>::iterator,
+	                           ez::direct_iterator<double>>::value, "");
+	static_assert(std::is_same<ez::ropen_interval<std::list<int>::iterator>::iterator,
+	                           ez::direct_iterator<std::list<int>::iterator>>::value, "");
+
+	auto const max = std::numeric_limits<int>::max();
+	std::vector<int> values;
+	for(auto i : ez::make_interval[max - 2][max]) {
+		values.push_back(i);
+	}
+	BOOST_CHECK((values == std::vector<int>{max - 2, max - 1, max}));
+
+	auto const r = ez::make_interval(max - 3)[max];
+	std::vector<int> reversed;
+	for(auto it = r.end(); it != r.begin();) {
+		reversed.push_back(*--it);
+	}
+	BOOST_CHECK((reversed == std::vector<int>{max, max - 1, max - 2}));
+
+	typedef unsigned char uchar_t;
+	auto const uchar = ez::make_interval[uchar_t{250}][uchar_t{255}];
+	BOOST_CHECK_EQUAL(std::distance(uchar.begin(), uchar.end()), 6);
+	BOOST_CHECK_EQUAL(uchar.begin()[5], 255);
+}
+
 BOOST_AUTO_TEST_CASE(EqualityTest) {
 	BOOST_CHECK_EQUAL(ez::make_interval[0][3], ez::make_interval[0][3]);
 	BOOST_CHECK_EQUAL(ez::make_interval[0.0][3.0], ez::make_interval[0.0][3.0]);
@@ -0,0 +1,108 @@
+#include "ez/checked.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(checked)
+
+BOOST_AUTO_TEST_CASE(TryInterval) {
+	auto const a = ez::try_interval(0, 3, false, true);
+	BOOST_REQUIRE(a.has_value());
+	BOOST_CHECK_EQUAL(*a, ez::make_interval[0](3));
+	BOOST_CHECK_EQUAL(a.value(), ez::make_interval[0](3));
+
+	auto const b = ez::try_interval(2, 2, ez::left_open);
+	BOOST_REQUIRE(!b);
+	BOOST_CHECK(b.error() == ez::errc::empty_interval);
+	BOOST_CHECK_THROW(b.value(), ez::empty_interval);
+	BOOST_CHECK_EQUAL(b.value_or(ez::make_interval[1][1]), ez::make_interval[1][1]);
+
+	auto const c = ez::try_interval<true, true>(1.5, 2.5);
+	BOOST_REQUIRE(c);
+	BOOST_CHECK_EQUAL(c->lower(), 1.5);
+	BOOST_CHECK_EQUAL(c->upper(), 2.5);
+	BOOST_CHECK(!(ez::try_interval<false, false>(2, 1)));
+
+	auto const nan = std::numeric_limits<double>::quiet_NaN();
+	BOOST_CHECK(!ez::try_interval(nan, 1.0, ez::closed));
+}
+
+BOOST_AUTO_TEST_CASE(CopyAndAssign) {
+	ez::result<ez::interval<int>> a = ez::try_interval(0, 3, ez::closed);
+	ez::result<ez::interval<int>> b = ez::errc::divide_by_zero;
+	auto c = a;
+	BOOST_CHECK_EQUAL(*c, ez::make_interval[0][3]);
+	c = b;
+	BOOST_REQUIRE(!c);
+	BOOST_CHECK(c.error() == ez::errc::divide_by_zero);
+	BOOST_CHECK_THROW(c.value(), ez::divide_by_zero);
+	c = std::move(a);
+	BOOST_CHECK_EQUAL(*c, ez::make_interval[0][3]);
+
+	ez::result<std::string> s = std::string{"abc"};
+	auto t = s;
+	t = ez::errc::empty_interval;
+	t = s;
+	BOOST_CHECK_EQUAL(*t, "abc");
+}
+
+BOOST_AUTO_TEST_CASE(MatchesOperators) {
+	auto const a = ez::make_interval[-2](3);
+	auto const b = ez::make_interval(1)[4];
+	BOOST_CHECK_EQUAL(ez::checked_add(a, b).value(), a + b);
+	BOOST_CHECK_EQUAL(ez::checked_sub(a, b).value(), a - b);
+	BOOST_CHECK_EQUAL(ez::checked_mul(a, b).value(), a * b);
+	BOOST_CHECK_EQUAL(ez::checked_div(a, b).value(), a / b);
+	BOOST_CHECK_EQUAL(ez::checked_add(a, 2).value(), ez::make_interval[0](5));
+	BOOST_CHECK_EQUAL(ez::checked_sub(a, 2).value(), ez::make_interval[-4](1));
+
+	ez::interval<double> const c = ez::make_interval[-2.0](3.0);
+	ez::interval<double> const d = ez::make_interval(0.5)[4.0];
+	BOOST_CHECK_EQUAL(ez::checked_mul(c, d).value(), c * d);
+	BOOST_CHECK_EQUAL(ez::checked_div(c, d).value(), c / d);
+	BOOST_CHECK_EQUAL(ez::checked_mul(c, 2.0).value(), c * 2.0);
+	BOOST_CHECK_EQUAL(ez::checked_div(c, 2.0).value(), c / 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(Errors) {
+	auto const a = ez::try_interval(1.0, 2.0, ez::closed).value();
+	auto const r = ez::checked_div(a, ez::try_interval(-1.0, 1.0, ez::open).value());
+	BOOST_REQUIRE(!r);
+	BOOST_CHECK(r.error() == ez::errc::divide_by_zero);
+	BOOST_CHECK(ez::checked_div(a, 0.0).error() == ez::errc::divide_by_zero);
+
+	auto const nan = std::numeric_limits<double>::quiet_NaN();
+	BOOST_CHECK(ez::checked_mul(a, nan).error() == ez::errc::empty_interval);
+
+	auto const inf = std::numeric_limits<double>::infinity();
+	auto const whole = ez::try_interval(-inf, inf, ez::closed).value();
+	BOOST_CHECK(ez::checked_add(whole, whole).has_value());
+	BOOST_CHECK(ez::checked_sub(ez::make_interval[inf][inf], ez::make_interval[inf][inf]).error() ==
+	            ez::errc::empty_interval);
+}
+
+BOOST_AUTO_TEST_CASE(ScaleByNegative) {
+	ez::interval<int> a = ez::make_interval[1](3);
+	BOOST_CHECK_EQUAL(ez::checked_mul(a, -2).value(), ez::make_interval(-6)[-2]);
+	BOOST_CHECK_EQUAL(ez::checked_mul(a, 0).value(), ez::make_interval[0][0]);
+
+	a *= -1;
+	BOOST_CHECK_EQUAL(a, ez::make_interval(-3)[-1]);
+
+	ez::interval<double> b = ez::make_interval[1.0](4.0);
+	b /= -2.0;
+	BOOST_CHECK_EQUAL(b, ez::make_interval(-2.0)[-0.5]);
+}
+
+BOOST_AUTO_TEST_CASE(AssignChecksNewBounds) {
+	ez::interval<int> a = ez::make_interval[0](3);
+	BOOST_CHECK_THROW(a.assign(3, 3), ez::empty_interval);
+	BOOST_CHECK_EQUAL(a, ez::make_interval[0](3));
+	a.assign(4, 5);
+	BOOST_CHECK_EQUAL(a, ez::make_interval[4](5));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
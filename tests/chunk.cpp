@@ -0,0 +1,87 @@
+#include "ez/chunk.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(chunk)
+
+BOOST_AUTO_TEST_CASE(TypeChecks) {
+	typedef ez::chunk_iterator<int> iterator;
+	static_assert(std::is_same<std::random_access_iterator_tag,
+	                           iterator::iterator_category>::value, "");
+	static_assert(std::is_same<ez::ropen_interval<int> const&,
+	                           decltype(*std::declval<iterator>())>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(Chunks) {
+	{
+		auto const c = ez::chunks(ez::make_interval[0][9], 4);
+		BOOST_REQUIRE_EQUAL(c.size(), 3);
+		BOOST_CHECK_EQUAL(c.chunk_size(), 4);
+		BOOST_CHECK_EQUAL(c[0], ez::make_interval[0](4));
+		BOOST_CHECK_EQUAL(c[1], ez::make_interval[4](8));
+		BOOST_CHECK_EQUAL(c[2], ez::make_interval[8](10));
+		BOOST_CHECK_EQUAL(c.front(), ez::make_interval[0](4));
+		BOOST_CHECK_EQUAL(c.back(), ez::make_interval[8](10));
+
+		std::vector<ez::ropen_interval<int>> tiles(c.begin(), c.end());
+		BOOST_REQUIRE_EQUAL(tiles.size(), 3u);
+		BOOST_CHECK(std::equal(tiles.begin(), tiles.end(), c.begin()));
+		BOOST_CHECK_EQUAL(c.end() - c.begin(), 3);
+		BOOST_CHECK_EQUAL(*(c.begin() + 2), c[2]);
+		BOOST_CHECK_EQUAL(*(c.end() - 1), c[2]);
+		BOOST_CHECK_EQUAL(*--(--c.end()), c[1]);
+		BOOST_CHECK_EQUAL(c.begin()[1], c[1]);
+	}
+
+	{
+		auto const c = ez::chunks(ez::make_interval(0)(9), 4);
+		BOOST_REQUIRE_EQUAL(c.size(), 2);
+		BOOST_CHECK_EQUAL(c[0], ez::make_interval[1](5));
+		BOOST_CHECK_EQUAL(c[1], ez::make_interval[5](9));
+	}
+
+	{
+		auto const c = ez::chunks(ez::interval<int>{0, 8, ez::right_open}, 4);
+		BOOST_REQUIRE_EQUAL(c.size(), 2);
+		BOOST_CHECK_EQUAL(c.back(), ez::make_interval[4](8));
+	}
+
+	BOOST_CHECK(ez::chunks(ez::make_interval(0)(1), 4).empty());
+	BOOST_CHECK(ez::chunks(ez::make_interval(0)(1), 4).begin() ==
+	            ez::chunks(ez::make_interval(0)(1), 4).end());
+
+	BOOST_CHECK_THROW(ez::chunks(ez::make_interval[0](10), 0), ez::invalid_chunk_size);
+	BOOST_CHECK_THROW(ez::chunks(ez::make_interval[0](10), -3), ez::invalid_chunk_size);
+
+	auto const max = std::numeric_limits<int>::max();
+	BOOST_CHECK_THROW(ez::chunks(ez::make_interval[0][max], 4), ez::empty_interval);
+}
+
+BOOST_AUTO_TEST_CASE(Coverage) {
+	std::vector<int> vec(1000);
+	std::size_t next = 0;
+	for(auto tile : ez::chunks(ez::indices(vec), 64)) {
+		BOOST_CHECK_EQUAL(tile.lower(), next);
+		BOOST_CHECK(tile.size() <= 64);
+		for(auto i : tile) {
+			vec[i] += 1;
+		}
+		next = tile.upper();
+	}
+	BOOST_CHECK_EQUAL(next, vec.size());
+	BOOST_CHECK(std::all_of(vec.begin(), vec.end(), [](int i){ return i == 1; }));
+
+	auto const it = ez::chunks(ez::iterate(vec), 300);
+	BOOST_REQUIRE_EQUAL(it.size(), 4);
+	BOOST_CHECK(it.back().lower() == vec.begin() + 900);
+	BOOST_CHECK(it.back().upper() == vec.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+#include "ez/compact_interval.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+static_assert(sizeof(ez::compact_interval<double>) == 2 * sizeof(double), "");
+static_assert(sizeof(ez::compact_interval<float>) == 2 * sizeof(float), "");
+static_assert(sizeof(ez::compact_interval<std::int32_t*>) == 2 * sizeof(std::int32_t*), "");
+static_assert(ez::is_interval<ez::compact_interval<double>>::value, "");
+
+double next(double x) {
+	return std::nextafter(x, std::numeric_limits<double>::infinity());
+}
+
+double prior(double x) {
+	return std::nextafter(x, -std::numeric_limits<double>::infinity());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(compact_interval)
+
+BOOST_AUTO_TEST_CASE(FloatingPoint) {
+	using ez::make_interval;
+	typedef ez::compact_interval<double> compact;
+
+	compact const closed = make_interval[1.0][2.0];
+	BOOST_CHECK_EQUAL(closed, make_interval[1.0][2.0]);
+
+	compact const open = make_interval(1.0)(2.0);
+	BOOST_CHECK_EQUAL(open.lower(), next(1.0));
+	BOOST_CHECK_EQUAL(open.upper(), prior(2.0));
+	BOOST_CHECK(open.left_closed());
+	BOOST_CHECK(open.right_closed());
+
+	// The same numbers are held as by the original interval
+	ez::interval<double> const original{1.0, 2.0, ez::open};
+	for(double x : {prior(1.0), 1.0, next(1.0), 1.5, prior(2.0), 2.0, next(2.0)}) {
+		BOOST_CHECK_EQUAL(contains(open, x), contains(original, x));
+	}
+
+	BOOST_CHECK_EQUAL(ez::interval<double>{open}, make_interval[next(1.0)][prior(2.0)]);
+	BOOST_CHECK_EQUAL(intersection(open, make_interval[0.0][1.5]), make_interval[next(1.0)][1.5]);
+	BOOST_CHECK_EQUAL(hull(open, make_interval(0.0)[1.5]), make_interval(0.0)[prior(2.0)]);
+
+	// Infinite bounds are kept when closed and become the largest finite value when open
+	double const inf = std::numeric_limits<double>::infinity();
+	double const max = std::numeric_limits<double>::max();
+	BOOST_CHECK_EQUAL(compact(-inf, inf, ez::closed), make_interval[-inf][inf]);
+	BOOST_CHECK_EQUAL(compact(-inf, inf, ez::open), make_interval[-max][max]);
+
+	BOOST_CHECK_THROW(compact(2.0, 1.0, ez::closed), ez::empty_interval);
+	BOOST_CHECK_THROW(compact(1.0, 1.0, ez::right_open), ez::empty_interval);
+	BOOST_CHECK_THROW(compact(1.0, next(1.0), ez::open), ez::empty_interval);
+	BOOST_CHECK_EQUAL(compact(1.0, next(1.0), ez::right_open), make_interval[1.0][1.0]);
+}
+
+BOOST_AUTO_TEST_CASE(Pointer) {
+	typedef ez::compact_interval<std::int32_t*> compact;
+	std::int32_t values[8] = {};
+	std::int32_t* const first = values;
+	std::int32_t* const last = values + 8;
+
+	for(int open = 0; open != 4; ++open) {
+		ez::interval<std::int32_t*> const original{first, last, static_cast<ez::openness>(open)};
+		compact const r = original;
+		BOOST_CHECK_EQUAL(r.lower(), first);
+		BOOST_CHECK_EQUAL(r.upper(), last);
+		BOOST_CHECK_EQUAL(r.left_open(), original.left_open());
+		BOOST_CHECK_EQUAL(r.right_open(), original.right_open());
+		BOOST_CHECK(r == original);
+		BOOST_CHECK(ez::interval<std::int32_t*>{r} == original);
+		for(std::int32_t* p = first; p != last + 1; ++p) {
+			BOOST_CHECK_EQUAL(contains(r, p), contains(original, p));
+		}
+	}
+
+	BOOST_CHECK_THROW(compact(first, first, ez::left_open), ez::empty_interval);
+	BOOST_CHECK(ez::compact_interval<std::int32_t*>{ez::make_interval[first](last)} ==
+	            ez::make_interval[first](last));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
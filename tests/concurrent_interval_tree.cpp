@@ -0,0 +1,108 @@
+#include "ez/concurrent_interval_tree.hpp"
+#include "ostream.hpp"
+#include "random_interval.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(concurrent_interval_tree)
+
+BOOST_AUTO_TEST_CASE(Queries) {
+	ez::concurrent_interval_tree<int, std::string> tree{3};
+	tree.insert(ez::make_interval[0](10), "a");
+	auto const b = tree.insert(ez::make_interval(5)[20], "b");
+	tree.insert(ez::make_interval[10][10], "c");
+	BOOST_CHECK_EQUAL(tree.size(), 3u);
+	BOOST_CHECK_EQUAL(tree.value(b), "b");
+
+	std::string found;
+	auto const append = [&](ez::interval<int> const&, std::string const& s){ found += s; };
+	tree.containing(7, append);
+	std::sort(found.begin(), found.end());
+	BOOST_CHECK_EQUAL(found, "ab");
+
+	found.clear();
+	tree.overlapping(ez::make_interval[10][30], append);
+	std::sort(found.begin(), found.end());
+	BOOST_CHECK_EQUAL(found, "bc");
+
+	tree.erase(b);
+	BOOST_CHECK_EQUAL(tree.size(), 2u);
+	found.clear();
+	tree.overlapping(ez::make_interval[0][20], append);
+	std::sort(found.begin(), found.end());
+	BOOST_CHECK_EQUAL(found, "ac");
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentWriters) {
+	ez::concurrent_interval_tree<int, int> tree{4};
+	int const threads = 4;
+	int const per_thread = 2000;
+
+	// Each writer inserts its intervals and erases every other one, while a reader keeps querying
+	std::atomic<bool> done{false};
+	std::atomic<int> bad{0};
+	std::thread reader{[&]{
+		std::mt19937 engine{1};
+		while(!done.load()) {
+			auto const query = test::random_interval<int>(engine, 100);
+			tree.overlapping(query, [&](ez::interval<int> const& r, int) {
+				bad += !test::overlaps(r, query);
+			});
+		}
+	}};
+
+	std::vector<std::vector<std::pair<ez::interval<int>, int>>> kept(threads);
+	std::vector<std::thread> writers;
+	for(int t = 0; t < threads; ++t) {
+		writers.emplace_back([&, t]{
+			std::mt19937 engine{static_cast<unsigned>(t + 2)};
+			for(int i = 0; i < per_thread; ++i) {
+				auto const r = test::random_interval<int>(engine, 100);
+				auto const value = t * per_thread + i;
+				auto const h = tree.insert(r, value);
+				if(i % 2 == 0) {
+					tree.erase(h);
+				} else {
+					kept[t].emplace_back(r, value);
+				}
+			}
+		});
+	}
+	for(auto& writer : writers) {
+		writer.join();
+	}
+	done = true;
+	reader.join();
+	BOOST_CHECK_EQUAL(bad.load(), 0);
+	BOOST_CHECK_EQUAL(tree.size(), static_cast<std::size_t>(threads * per_thread / 2));
+
+	std::mt19937 engine{0};
+	for(int round = 0; round < 200; ++round) {
+		auto const query = test::random_interval<int>(engine, 100);
+		std::vector<int> expected;
+		for(auto const& k : kept) {
+			for(auto const& s : k) {
+				if(test::overlaps(s.first, query)) {
+					expected.push_back(s.second);
+				}
+			}
+		}
+		std::vector<int> actual;
+		tree.overlapping(query, [&](ez::interval<int> const&, int value) {
+			actual.push_back(value);
+		});
+		std::sort(expected.begin(), expected.end());
+		std::sort(actual.begin(), actual.end());
+		BOOST_CHECK(expected == actual);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+#include "ez/interval.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+// Construction, comparison and the functions with a single return statement are constexpr in
+// C++11
+constexpr auto digits = ez::make_interval[0](10);
+static_assert(digits.lower() == 0 && digits.upper() == 10, "");
+static_assert(digits.size() == 10, "");
+static_assert(contains(digits, 9) && !contains(digits, 10), "");
+static_assert(diameter(ez::make_interval[2][7]) == 5, "");
+static_assert(midpoint(ez::make_interval[2][8]) == 5, "");
+static_assert(ez::radius<double>(ez::make_interval[2][7]) == 2.5, "");
+static_assert(singleton(ez::make_interval[3][3]), "");
+static_assert(ez::make_interval[1](3) == ez::interval<int>(1, 3, false, true), "");
+static_assert(ez::make_interval[1](3) != ez::interval<int>(1, 3, ez::open), "");
+static_assert(make_closed(ez::make_interval(1)(3)) == ez::make_interval[1][3], "");
+static_assert(ez::interval_cast<long>(digits).upper() == 10L, "");
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304
+
+// Iteration, arithmetic and the set functions need the relaxed constexpr rules of C++14
+constexpr int sum(ez::ropen_interval<int> const& r) {
+	int total = 0;
+	for(int i : r) {
+		total += i;
+	}
+	return total;
+}
+
+static_assert(sum(ez::make_interval[0](5)) == 10, "");
+static_assert(ez::make_interval[1][2] + ez::make_interval[3][4] == ez::make_interval[4][6], "");
+static_assert(ez::make_interval[1](3) + 2 == ez::make_interval[3](5), "");
+static_assert(ez::make_interval[4][6] - ez::make_interval[1][2] == ez::make_interval[2][5], "");
+static_assert(ez::interval<int>(-2, 3, ez::closed) * ez::interval<int>(1, 4, ez::right_open) ==
+                ez::interval<int>(-8, 12, ez::open),
+              "");
+static_assert(ez::interval<int>(0, 3, ez::closed) * ez::interval<int>(-1, 2, ez::closed) ==
+                ez::interval<int>(-3, 6, ez::closed),
+              "");
+static_assert(ez::interval<double>(1, 2, ez::closed) / ez::interval<double>(2, 4, ez::closed) ==
+                ez::interval<double>(0.25, 1, ez::closed),
+              "");
+static_assert(intersection(ez::make_interval[3](6), ez::make_interval[1](8)) ==
+                ez::make_interval[3](6),
+              "");
+static_assert(hull(ez::make_interval[3][9], ez::make_interval(1)(8)) == ez::make_interval(1)[9],
+              "");
+static_assert(subset(ez::make_interval[3][4], ez::make_interval[1][8]), "");
+static_assert(proper_superset(ez::make_interval[1][8], ez::make_interval[3][4]), "");
+
+#endif
+
+}
+
+BOOST_AUTO_TEST_SUITE(constexpr_intervals)
+
+BOOST_AUTO_TEST_CASE(constexpr_functions_run_at_runtime) {
+	// The same expressions must still work, and throw, outside of constant expressions
+	auto const r = ez::make_interval[1][2] + ez::make_interval[3][4];
+	BOOST_CHECK_EQUAL(r, ez::make_interval[4][6]);
+	BOOST_CHECK_THROW(ez::interval<int>(3, 1, ez::closed), ez::empty_interval);
+	BOOST_CHECK_THROW((ez::closed_interval<int>{3, 1}), ez::empty_interval);
+	BOOST_CHECK_THROW(ez::make_interval[0][1] / 0, ez::divide_by_zero);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+#include "ez/contains_bulk.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename T>
+void check_matches_contains(std::vector<T> const& values) {
+	for(int o = 0; o < 4; ++o) {
+		ez::interval<T> const r{T(-5), T(5), static_cast<ez::openness>(o)};
+		for(std::size_t n = 0; n <= values.size(); n += 13) {
+			std::vector<std::uint64_t> bits((n + 63) / 64, ~std::uint64_t{0});
+			ez::contains_bulk(r, values.data(), n, bits.data());
+			std::size_t expected_count = 0;
+			for(std::size_t i = 0; i < bits.size() * 64; ++i) {
+				auto const expected = i < n && ez::contains(r, values[i]);
+				BOOST_CHECK_EQUAL((bits[i / 64] >> (i % 64)) & 1u, expected);
+				expected_count += expected;
+			}
+			BOOST_CHECK_EQUAL(ez::count_contained(r, values.data(), n), expected_count);
+		}
+	}
+}
+
+template <typename T>
+std::vector<T> random_values(std::mt19937& engine) {
+	std::uniform_int_distribution<int> value{-7, 7};
+	std::vector<T> values;
+	for(int i = 0; i < 300; ++i) {
+		values.push_back(static_cast<T>(value(engine)));
+	}
+	return values;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(contains_bulk)
+
+BOOST_AUTO_TEST_CASE(Example) {
+	int const values[] = {-1, 0, 3, 5, 9};
+	std::uint64_t bits;
+	ez::contains_bulk(ez::make_interval(0)[5], values, 5, &bits);
+	BOOST_CHECK_EQUAL(bits, 12u);
+	BOOST_CHECK_EQUAL(ez::count_contained(ez::make_interval[0][5], values, 5), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesContains) {
+	std::mt19937 engine{19};
+	check_matches_contains(random_values<std::int32_t>(engine));
+	check_matches_contains(random_values<std::int64_t>(engine));
+	check_matches_contains(random_values<short>(engine));
+
+	auto doubles = random_values<double>(engine);
+	doubles[70] = std::numeric_limits<double>::quiet_NaN();
+	doubles[71] = 0.5;
+	check_matches_contains(doubles);
+
+	auto floats = random_values<float>(engine);
+	floats[3] = std::numeric_limits<float>::quiet_NaN();
+	floats[4] = -4.5f;
+	check_matches_contains(floats);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,10 @@
+// Exits with 0 if the processor supports the instruction set EZ_CPU_FEATURE, such as avx2. CMake
+// runs this to decide whether the tests built for that instruction set can run on this machine.
+
+#define EZ_STRINGIFY_(x) #x
+#define EZ_STRINGIFY(x) EZ_STRINGIFY_(x)
+
+int main() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports(EZ_STRINGIFY(EZ_CPU_FEATURE)) ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+#include "ez/discrete_interval.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <climits>
+#include <vector>
+
+namespace {
+
+static_assert(sizeof(ez::discrete_interval<int>) == 2 * sizeof(int), "");
+static_assert(ez::discrete_interval<int>{ez::make_interval(2)(6)}.lower() == 3, "");
+static_assert(ez::discrete_interval<int>{ez::make_interval(2)(6)}.upper() == 5, "");
+static_assert(contains(ez::discrete_interval<int>{1, 3}, 3), "");
+static_assert(!contains(ez::discrete_interval<int>{1, 3}, 4), "");
+static_assert(intersection(ez::discrete_interval<int>{1, 5},
+                           ez::discrete_interval<int>{3, 8}) == ez::discrete_interval<int>{3, 5},
+              "");
+static_assert(hull(ez::discrete_interval<int>{1, 2},
+                   ez::discrete_interval<int>{6, 8}) == ez::discrete_interval<int>{1, 8}, "");
+
+}
+
+BOOST_AUTO_TEST_SUITE(discrete_interval)
+
+BOOST_AUTO_TEST_CASE(Canonicalization) {
+	using ez::make_interval;
+	typedef ez::discrete_interval<int> discrete;
+
+	BOOST_CHECK_EQUAL(discrete{make_interval[2][6]}, (discrete{2, 6}));
+	BOOST_CHECK_EQUAL(discrete{make_interval(2)[6]}, (discrete{3, 6}));
+	BOOST_CHECK_EQUAL(discrete{make_interval[2](6)}, (discrete{2, 5}));
+	BOOST_CHECK_EQUAL(discrete{make_interval(2)(6)}, (discrete{3, 5}));
+	BOOST_CHECK_EQUAL(discrete{make_interval(2)(4)}, (discrete{3, 3}));
+	BOOST_CHECK_EQUAL(discrete{ez::interval<int>{make_interval(2)[6]}}, (discrete{3, 6}));
+
+	BOOST_CHECK_THROW(discrete(make_interval(2)(3)), ez::empty_interval);
+	BOOST_CHECK_THROW(discrete(ez::interval<int>{make_interval(2)(3)}), ez::empty_interval);
+	BOOST_CHECK_THROW(discrete(3, 2), ez::empty_interval);
+
+	// Open bounds at the limits of int do not overflow
+	BOOST_CHECK_EQUAL(discrete{make_interval(INT_MAX - 1)[INT_MAX]}, (discrete{INT_MAX, INT_MAX}));
+	BOOST_CHECK_EQUAL(discrete{make_interval[INT_MIN](INT_MIN + 1)}, (discrete{INT_MIN, INT_MIN}));
+}
+
+BOOST_AUTO_TEST_CASE(Conversion) {
+	using ez::make_interval;
+
+	// Converting back and forth holds the same integers
+	for(int l = -3; l != 3; ++l) {
+		for(int u = l; u != 4; ++u) {
+			for(int open = 0; open != 4; ++open) {
+				bool const lo = (open & 1) != 0;
+				bool const ro = (open & 2) != 0;
+				if(!ez::detail::valid(l, u, lo, ro)) {
+					continue;
+				}
+
+				ez::interval<int> const r{l, u, lo, ro};
+				if(r.size() == 0) {
+					BOOST_CHECK_THROW(ez::discrete_interval<int>{r}, ez::empty_interval);
+					continue;
+				}
+
+				ez::discrete_interval<int> const d{r};
+				ez::interval<int> const back = d;
+				ez::closed_interval<int> const closed = d;
+				std::vector<int> const expected(r.begin(), r.end());
+				BOOST_CHECK_EQUAL_COLLECTIONS(d.begin(), d.end(), expected.begin(), expected.end());
+				BOOST_CHECK_EQUAL_COLLECTIONS(back.begin(), back.end(), expected.begin(),
+				                              expected.end());
+				BOOST_CHECK_EQUAL(closed, back);
+				BOOST_CHECK_EQUAL(d.size(), r.size());
+				BOOST_CHECK_EQUAL(ez::discrete_interval<int>{back}, d);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Predicates) {
+	typedef ez::discrete_interval<int> discrete;
+	discrete const a{1, 5};
+	discrete const b{2, 4};
+	discrete const c{6, 8};
+
+	BOOST_CHECK(contains(a, 1));
+	BOOST_CHECK(contains(a, 5));
+	BOOST_CHECK(!contains(a, 0));
+	BOOST_CHECK(!contains(a, 6));
+
+	BOOST_CHECK(subset(b, a));
+	BOOST_CHECK(subset(a, a));
+	BOOST_CHECK(!subset(a, b));
+	BOOST_CHECK(superset(a, b));
+	BOOST_CHECK(proper_subset(b, a));
+	BOOST_CHECK(!proper_subset(a, a));
+	BOOST_CHECK(proper_superset(a, b));
+	BOOST_CHECK(!proper_superset(a, a));
+
+	BOOST_CHECK(overlaps(a, b));
+	BOOST_CHECK(!overlaps(a, c));
+	BOOST_CHECK(overlaps(a, discrete{5, 9}));
+
+	BOOST_CHECK_EQUAL(intersection(a, b), b);
+	BOOST_CHECK_EQUAL(intersection(a, discrete{4, 9}), (discrete{4, 5}));
+	BOOST_CHECK_THROW(intersection(a, c), ez::empty_interval);
+
+	BOOST_CHECK_EQUAL(hull(a, c), (discrete{1, 8}));
+	BOOST_CHECK_EQUAL(hull(b, a), a);
+}
+
+BOOST_AUTO_TEST_CASE(Arithmetic) {
+	typedef ez::discrete_interval<int> discrete;
+	BOOST_CHECK_EQUAL((discrete{1, 2} + discrete{-3, 4}), (discrete{-2, 6}));
+	BOOST_CHECK_EQUAL((discrete{1, 2} - discrete{-3, 4}), (discrete{-3, 5}));
+}
+
+BOOST_AUTO_TEST_CASE(Assign) {
+	ez::discrete_interval<long> r{0, 0};
+	r.assign(-2, 3);
+	BOOST_CHECK_EQUAL(r.lower(), -2);
+	BOOST_CHECK_EQUAL(r.upper(), 3);
+	BOOST_CHECK_THROW(r.assign(3, -2), ez::empty_interval);
+	BOOST_CHECK_EQUAL(r.size(), 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+#include "ez/grouped_intervals.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<ez::interval<int>> random_intervals(std::size_t n) {
+	std::mt19937 engine{7};
+	std::uniform_int_distribution<int> value{-20, 20};
+	std::uniform_int_distribution<int> open{0, 3};
+	std::vector<ez::interval<int>> intervals;
+	while(intervals.size() < n) {
+		auto const a = value(engine);
+		auto const b = a + 1 + value(engine) % 8 + 8;
+		intervals.emplace_back(a, b, static_cast<ez::openness>(open(engine)));
+	}
+	return intervals;
+}
+
+// Records each call so that the order and the openness of the arguments can be checked
+struct record {
+	std::vector<std::size_t>* indices;
+	std::vector<ez::interval<int>>* intervals;
+
+	template <bool LOpen, bool ROpen>
+	void operator()(std::size_t i, ez::basic_interval<int, LOpen, ROpen> const& r) const {
+		indices->push_back(i);
+		intervals->push_back(r);
+	}
+};
+
+struct diameter {
+	template <bool LOpen, bool ROpen>
+	int operator()(ez::basic_interval<int, LOpen, ROpen> const& r) const {
+		return ez::diameter(r) * 10 + LOpen + 2 * ROpen;
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(grouped_intervals)
+
+BOOST_AUTO_TEST_CASE(Empty) {
+	ez::grouped_intervals<int> const g;
+	BOOST_CHECK_EQUAL(g.size(), 0u);
+	BOOST_CHECK_EQUAL(g.count_containing(0), 0u);
+
+	ez::grouped_intervals<int> const h{nullptr, 0};
+	BOOST_CHECK_EQUAL(h.size(ez::open), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Contains) {
+	auto const intervals = random_intervals(1000);
+	ez::grouped_intervals<int> const g{intervals.data(), intervals.size()};
+	BOOST_CHECK_EQUAL(g.size(), intervals.size());
+	BOOST_CHECK_EQUAL(g.size(ez::closed) + g.size(ez::left_open) + g.size(ez::right_open) +
+	                  g.size(ez::open), intervals.size());
+
+	for(int x = -25; x != 35; ++x) {
+		std::size_t expected = 0;
+		for(auto const& r : intervals) {
+			expected += contains(r, x);
+		}
+		BOOST_CHECK_EQUAL(g.count_containing(x), expected);
+
+		bool hits[1000];
+		g.contains(x, hits);
+		for(std::size_t i = 0; i < intervals.size(); ++i) {
+			BOOST_CHECK_EQUAL(hits[i], contains(intervals[i], x));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ForEach) {
+	auto const intervals = random_intervals(200);
+	ez::grouped_intervals<int> const g{intervals.data(), intervals.size()};
+
+	std::vector<std::size_t> indices;
+	std::vector<ez::interval<int>> visited;
+	g.for_each(record{&indices, &visited});
+	BOOST_REQUIRE_EQUAL(indices.size(), intervals.size());
+
+	std::vector<bool> seen(intervals.size());
+	for(std::size_t j = 0; j < indices.size(); ++j) {
+		BOOST_CHECK_EQUAL(visited[j], intervals[indices[j]]);
+		seen[indices[j]] = true;
+
+		// Each group is visited in its original order
+		if(j != 0 && visited[j - 1].left_open() == visited[j].left_open() &&
+		   visited[j - 1].right_open() == visited[j].right_open()) {
+			BOOST_CHECK_LT(indices[j - 1], indices[j]);
+		}
+	}
+	BOOST_CHECK(std::find(seen.begin(), seen.end(), false) == seen.end());
+}
+
+BOOST_AUTO_TEST_CASE(Transform) {
+	auto const intervals = random_intervals(200);
+	ez::grouped_intervals<int> const g{intervals.data(), intervals.size()};
+
+	std::vector<int> out(intervals.size());
+	g.transform(diameter{}, out.data());
+	for(std::size_t i = 0; i < intervals.size(); ++i) {
+		BOOST_CHECK_EQUAL(out[i], ez::diameter(intervals[i]) * 10 + intervals[i].left_open() +
+		                          2 * intervals[i].right_open());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
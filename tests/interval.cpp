@@ -3,6 +3,87 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// All intervals with bounds taken from values
+template <typename T>
+std::vector<ez::interval<T>> all_intervals(std::vector<T> const& values) {
+	std::vector<ez::interval<T>> result;
+	for(auto lower : values) {
+		for(auto upper : values) {
+			for(auto o : {ez::closed, ez::left_open, ez::right_open, ez::open}) {
+				if(lower < upper || (lower == upper && o == ez::closed)) {
+					result.push_back(ez::interval<T>{lower, upper, o});
+				}
+			}
+		}
+	}
+	return result;
+}
+
+// Returns the result of f(l, r), or an empty optional-like pair if it throws empty_interval
+template <typename T, typename Function>
+std::pair<bool, ez::interval<T>> try_apply(ez::interval<T> l, ez::interval<T> const& r,
+                                           Function f) {
+	try {
+		f(l, r);
+		return {true, l};
+	} catch(ez::empty_interval const&) {
+		return {false, r};
+	}
+}
+
+// Checks that operator*= and operator/= give exactly the same results as the general path,
+// including the sign of zero bounds
+template <typename T>
+void check_matches_general(std::vector<T> const& values) {
+	auto const intervals = all_intervals(values);
+	for(auto const& l : intervals) {
+		for(auto const& r : intervals) {
+			auto const fast = try_apply(l, r, [](ez::interval<T>& a, ez::interval<T> const& b){
+				a *= b;
+			});
+			auto const general = try_apply(l, r, [](ez::interval<T>& a, ez::interval<T> const& b){
+				if(!ez::detail::general_multiply(a, b)) {
+					throw ez::empty_interval{};
+				}
+			});
+			BOOST_REQUIRE_EQUAL(fast.first, general.first);
+			BOOST_CHECK_EQUAL(fast.second, general.second);
+			BOOST_CHECK_EQUAL(std::signbit(fast.second.lower()),
+			                  std::signbit(general.second.lower()));
+			BOOST_CHECK_EQUAL(std::signbit(fast.second.upper()),
+			                  std::signbit(general.second.upper()));
+
+			if(!contains(ez::make_closed(r), T{0})) {
+				auto const fast = try_apply(l, r, [](ez::interval<T>& a, ez::interval<T> const& b){
+					a /= b;
+				});
+				auto const general = try_apply(l, r, [](ez::interval<T>& a,
+				                                        ez::interval<T> const& b){
+					if(!ez::detail::general_divide(a, b)) {
+						throw ez::empty_interval{};
+					}
+				});
+				BOOST_REQUIRE_EQUAL(fast.first, general.first);
+				BOOST_CHECK_EQUAL(fast.second, general.second);
+				BOOST_CHECK_EQUAL(std::signbit(fast.second.lower()),
+				                  std::signbit(general.second.lower()));
+				BOOST_CHECK_EQUAL(std::signbit(fast.second.upper()),
+				                  std::signbit(general.second.upper()));
+			}
+		}
+	}
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(interval)
 
 BOOST_AUTO_TEST_CASE(Constructor) {
@@ -58,6 +139,18 @@ BOOST_AUTO_TEST_CASE(BeginEndTest) {
 	BOOST_CHECK_EQUAL(*B.cend(), 4);
 }
 
+BOOST_AUTO_TEST_CASE(Size) {
+	BOOST_CHECK_EQUAL(ez::interval<int>(0, 4, ez::closed).size(), 5);
+	BOOST_CHECK_EQUAL(ez::interval<int>(0, 4, ez::right_open).size(), 4);
+	BOOST_CHECK_EQUAL(ez::interval<int>(0, 4, ez::left_open).size(), 4);
+	BOOST_CHECK_EQUAL(ez::interval<int>(0, 4, ez::open).size(), 3);
+
+	auto const max = std::numeric_limits<int>::max();
+	ez::interval<int> const A{max - 4, max, ez::left_open};
+	BOOST_CHECK_EQUAL(A.end() - A.begin(), 4);
+	BOOST_CHECK_EQUAL(std::accumulate(A.begin(), A.end(), 0LL), 4LL * max - 6);
+}
+
 BOOST_AUTO_TEST_CASE(EqualityTest) {
 	BOOST_CHECK_EQUAL(ez::interval<int>{ez::make_interval[0][3]}, ez::interval<int>{ez::make_interval[0][3]});
 	BOOST_CHECK_EQUAL(ez::make_interval[0.0][3.0], ez::make_interval[0.0][3.0]);
@@ -305,4 +398,60 @@ BOOST_AUTO_TEST_CASE(Arithmetic) {
 	BOOST_CHECK_EQUAL(C * D, D * C);
 }
 
+BOOST_AUTO_TEST_CASE(ScalarArithmetic) {
+	ez::interval<int> const A = ez::make_interval[1](3);
+
+	// A negative value swaps the bounds and their openness
+	BOOST_CHECK_EQUAL(A * -2, ez::interval<int>{ez::make_interval(-6)[-2]});
+	BOOST_CHECK_EQUAL(-2 * A, ez::interval<int>{ez::make_interval(-6)[-2]});
+	BOOST_CHECK_EQUAL(ez::interval<int>{ez::make_interval[-6](6)} / -2,
+	                  ez::interval<int>{ez::make_interval(-3)[3]});
+
+	// Multiplying by zero gives [0, 0] whatever the openness
+	BOOST_CHECK_EQUAL(A * 0, ez::interval<int>{ez::make_interval[0][0]});
+	BOOST_CHECK_EQUAL(ez::interval<int>{ez::make_interval(1)(3)} * 0,
+	                  ez::interval<int>{ez::make_interval[0][0]});
+	BOOST_CHECK_THROW(A / 0, ez::divide_by_zero);
+
+	// The value has the type of the bounds rather than difference_type
+	ez::interval<double> const B = ez::make_interval[1.0](3.0);
+	BOOST_CHECK_EQUAL(B * 0.5, ez::interval<double>{ez::make_interval[0.5](1.5)});
+	BOOST_CHECK_EQUAL(B / 0.5, ez::interval<double>{ez::make_interval[2.0](6.0)});
+	BOOST_CHECK_EQUAL(B * -0.5, ez::interval<double>{ez::make_interval(-1.5)[-0.5]});
+
+	// basic_interval swaps the bounds when they have the same openness
+	BOOST_CHECK_EQUAL(ez::make_interval[1][3] * -2, ez::make_interval[-6][-2]);
+	BOOST_CHECK_EQUAL(ez::make_interval(1)(3) * -2, ez::make_interval(-6)(-2));
+	BOOST_CHECK_EQUAL(ez::make_interval[2][6] / -2, ez::make_interval[-3][-1]);
+	BOOST_CHECK_EQUAL(ez::make_interval(2)(6) / -2, ez::make_interval(-3)(-1));
+	BOOST_CHECK_EQUAL(ez::make_interval[1][3] * 0, ez::make_interval[0][0]);
+	BOOST_CHECK_THROW(ez::make_interval(1)(3) * 0, ez::empty_interval);
+	BOOST_CHECK_THROW(ez::make_interval(2)(6) / 0, ez::divide_by_zero);
+
+	// and cannot swap them otherwise
+	BOOST_CHECK_EQUAL(ez::make_interval[1](3) * 2, ez::make_interval[2](6));
+	BOOST_CHECK_THROW(ez::make_interval[1](3) * -2, ez::empty_interval);
+	BOOST_CHECK_THROW(ez::make_interval(2)[6] / -2, ez::empty_interval);
+}
+
+BOOST_AUTO_TEST_CASE(AssignChecksNewBounds) {
+	ez::interval<int> A = ez::make_interval(0)(4);
+	A.assign(1, 2);
+	BOOST_CHECK_EQUAL(A, ez::interval<int>{ez::make_interval(1)(2)});
+	BOOST_CHECK_THROW(A.assign(3, 3), ez::empty_interval);
+	BOOST_CHECK_EQUAL(A, ez::interval<int>{ez::make_interval(1)(2)});
+
+	ez::interval<int> B = ez::make_interval[0][0];
+	B.assign(2, 5);
+	BOOST_CHECK_EQUAL(B, ez::interval<int>{ez::make_interval[2][5]});
+	BOOST_CHECK_THROW(B.assign(5, 2), ez::empty_interval);
+}
+
+BOOST_AUTO_TEST_CASE(MultiplyDivideMatchGeneral) {
+	auto const inf = std::numeric_limits<double>::infinity();
+	auto const tiny = std::numeric_limits<double>::denorm_min();
+	check_matches_general<double>({-inf, -3.0, -1.0, -tiny, -0.0, 0.0, tiny, 0.5, 1.0, 3.0, inf});
+	check_matches_general<int>({-3, -2, -1, 0, 1, 2, 5});
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+#include "ez/interval_array.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Intervals made from a few values so that equal bounds, zeros and signed zeros are common
+template <typename T>
+std::vector<ez::interval<T>> random_intervals(std::size_t n, std::vector<T> const& values,
+                                              std::mt19937& engine) {
+	std::uniform_int_distribution<std::size_t> pick{0, values.size() - 1};
+	std::uniform_int_distribution<int> open{0, 3};
+	std::vector<ez::interval<T>> result;
+	while(result.size() < n) {
+		auto a = values[pick(engine)];
+		auto b = values[pick(engine)];
+		if(b < a) {
+			std::swap(a, b);
+		}
+		auto const o = static_cast<ez::openness>(a == b ? 0 : open(engine));
+		result.push_back(ez::interval<T>{a, b, o});
+	}
+	return result;
+}
+
+// Checks the intervals are equal, including the sign of zero bounds
+template <typename T>
+void check_same(ez::interval<T> const& actual, ez::interval<T> const& expected) {
+	BOOST_CHECK_EQUAL(actual, expected);
+	BOOST_CHECK_EQUAL(std::signbit(actual.lower()), std::signbit(expected.lower()));
+	BOOST_CHECK_EQUAL(std::signbit(actual.upper()), std::signbit(expected.upper()));
+}
+
+template <typename T, typename ArrayOp, typename ScalarOp>
+void check_op(std::vector<ez::interval<T>> const& l, std::vector<ez::interval<T>> const& r,
+              ArrayOp array_op, ScalarOp scalar_op) {
+	ez::interval_array<T> const a(l.begin(), l.end());
+	ez::interval_array<T> const b(r.begin(), r.end());
+	auto const result = array_op(a, b);
+	BOOST_REQUIRE_EQUAL(result.size(), l.size());
+	for(std::size_t i = 0; i < l.size(); ++i) {
+		check_same(result[i], scalar_op(l[i], r[i]));
+	}
+}
+
+template <typename T>
+void check_matches_interval(std::vector<T> const& values, std::vector<T> const& divisors) {
+	typedef ez::interval_array<T> array;
+	typedef ez::interval<T> scalar;
+	std::mt19937 engine{42};
+
+	// Sizes around and between the vector widths so that both the blocks and the tail are used
+	for(std::size_t n : {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 1001}) {
+		auto const l = random_intervals(n, values, engine);
+		auto const r = random_intervals(n, values, engine);
+
+		check_op(l, r, [](array a, array const& b){ return a += b; },
+		               [](scalar a, scalar const& b){ return a += b; });
+		check_op(l, r, std::minus<array>{}, std::minus<scalar>{});
+		check_op(l, r, std::multiplies<array>{}, std::multiplies<scalar>{});
+		check_op(l, r, [](array const& a, array const& b){ return ez::hull(a, b); },
+		               [](scalar const& a, scalar const& b){ return ez::hull(a, b); });
+
+		// Divisors are positive or their negation, so they never contain zero
+		auto d = random_intervals(n, divisors, engine);
+		for(std::size_t i = 1; i < n; i += 2) {
+			d[i] = scalar{-d[i].upper(), -d[i].lower(), d[i].right_open(), d[i].left_open()};
+		}
+		check_op(l, d, std::divides<array>{}, std::divides<scalar>{});
+
+		// Intersect each interval with one that overlaps it
+		std::vector<scalar> overlapping;
+		for(auto const& x : l) {
+			overlapping.push_back(ez::interval<T>{x.lower(), values.back(), x.left_open(), false});
+		}
+		check_op(l, overlapping,
+		         [](array const& a, array const& b){ return ez::intersection(a, b); },
+		         [](scalar const& a, scalar const& b){ return ez::intersection(a, b); });
+
+		array const a(l.begin(), l.end());
+		std::vector<T> points;
+		for(std::size_t i = 0; i < n; ++i) {
+			points.push_back(values[i % values.size()]);
+		}
+		std::unique_ptr<bool[]> found{new bool[n + 1]};
+		ez::contains(a, points.data(), found.get());
+		for(std::size_t i = 0; i < n; ++i) {
+			BOOST_CHECK_EQUAL(found[i], ez::contains(l[i], points[i]));
+		}
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(interval_array)
+
+BOOST_AUTO_TEST_CASE(Container) {
+	ez::interval_array<int> a;
+	BOOST_CHECK(a.empty());
+	for(int i = 0; i < 20; ++i) {
+		a.push_back(ez::interval<int>{i, 2 * i, static_cast<ez::openness>(i % 4 * (i != 0))});
+	}
+	BOOST_CHECK_EQUAL(a.size(), 20u);
+	BOOST_CHECK_EQUAL(a[0], ez::make_interval[0][0]);
+	BOOST_CHECK_EQUAL(a[5], ez::make_interval(5)[10]);
+	BOOST_CHECK_EQUAL(a[6], ez::make_interval[6](12));
+	BOOST_CHECK_EQUAL(a[19], ez::make_interval(19)(38));
+	BOOST_CHECK_EQUAL(a.lower_data()[7], 7);
+	BOOST_CHECK_EQUAL(a.upper_data()[7], 14);
+
+	a.set(5, ez::make_interval[-1][1]);
+	BOOST_CHECK_EQUAL(a[5], ez::make_interval[-1][1]);
+	BOOST_CHECK_EQUAL(a[4], ez::make_interval[4][8]);
+	BOOST_CHECK_EQUAL(a[6], ez::make_interval[6](12));
+
+	ez::interval_array<int> const b(11, ez::make_interval(0)(2));
+	BOOST_CHECK_EQUAL(b.size(), 11u);
+	BOOST_CHECK_EQUAL(b[10], ez::make_interval(0)(2));
+	BOOST_CHECK(b == ez::interval_array<int>(11, ez::make_interval(0)(2)));
+	BOOST_CHECK(b != ez::interval_array<int>(11, ez::make_interval(0)[2]));
+	BOOST_CHECK(b != ez::interval_array<int>(10, ez::make_interval(0)(2)));
+
+	a.clear();
+	BOOST_CHECK(a.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Arithmetic) {
+	ez::interval_array<double> a = {ez::make_interval[0.0](1.0), ez::make_interval(-1.0)[2.0]};
+	ez::interval_array<double> const b = {ez::make_interval[2.0][3.0], ez::make_interval[1.0][1.0]};
+	a *= b;
+	BOOST_CHECK_EQUAL(a[0], ez::make_interval[0.0](3.0));
+	BOOST_CHECK_EQUAL(a[1], ez::make_interval(-1.0)[2.0]);
+
+	BOOST_CHECK_EQUAL((a + b)[0], ez::make_interval[2.0](6.0));
+	BOOST_CHECK_EQUAL((a - b)[1], ez::make_interval(-2.0)[1.0]);
+	BOOST_CHECK_EQUAL((a / b)[0], ez::make_interval[0.0](1.5));
+}
+
+BOOST_AUTO_TEST_CASE(Exceptions) {
+	ez::interval_array<double> a = {ez::make_interval[0.0][1.0], ez::make_interval[0.0][1.0]};
+	ez::interval_array<double> const zero = {ez::make_interval[1.0][2.0],
+	                                         ez::make_interval(0.0)[1.0]};
+	BOOST_CHECK_THROW(a /= zero, ez::divide_by_zero);
+	BOOST_CHECK(a == ez::interval_array<double>(2, ez::make_interval[0.0][1.0]));
+
+	ez::interval_array<double> const disjoint = {ez::make_interval[0.5][3.0],
+	                                             ez::make_interval(1.0)[3.0]};
+	BOOST_CHECK_THROW(ez::intersection(a, disjoint), ez::empty_interval);
+
+	ez::interval_array<double> const shorter(1, ez::make_interval[0.0][1.0]);
+	BOOST_CHECK_THROW(a + shorter, ez::size_mismatch);
+	BOOST_CHECK_THROW(ez::hull(a, shorter), ez::size_mismatch);
+
+	// Large enough that the disjoint pair is in a vector block
+	ez::interval_array<float> c(40, ez::make_interval[0.0f][1.0f]);
+	auto d = c;
+	d.set(3, ez::make_interval[2.0f][3.0f]);
+	BOOST_CHECK_THROW(ez::intersection(c, d), ez::empty_interval);
+	d.set(3, ez::make_interval[-1.0f][1.0f]);
+	BOOST_CHECK_THROW(c / d, ez::divide_by_zero);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesInterval) {
+	check_matches_interval<double>({-2.0, -1.0, -0.0, 0.0, 0.5, 1.0, 3.0},
+	                               {0.5, 1.0, 2.0, 4.0});
+	check_matches_interval<float>({-2.0f, -1.0f, -0.0f, 0.0f, 0.5f, 1.0f, 3.0f},
+	                              {0.5f, 1.0f, 2.0f, 4.0f});
+	// Dividing integer intervals can round to an empty interval, so only divide by one
+	check_matches_interval<int>({-2, -1, 0, 1, 3, 5}, {1});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+#include "ez/interval_file.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+template <typename Interval>
+std::string write(std::vector<Interval> const& intervals) {
+	std::ostringstream out{std::ios::binary};
+	ez::write_intervals(out, intervals.data(), intervals.size());
+	return out.str();
+}
+
+std::vector<ez::interval<double>> sample(std::size_t n) {
+	std::vector<ez::interval<double>> intervals;
+	for(std::size_t i = 0; i < n; ++i) {
+		auto const x = static_cast<double>(i) / 4.0;
+		intervals.emplace_back(x - 1.5, x, static_cast<ez::openness>(i % 4));
+	}
+	return intervals;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(interval_file)
+
+BOOST_AUTO_TEST_CASE(Format) {
+	std::vector<ez::interval<std::int32_t>> const intervals = {
+		{-1, 0x01020304, ez::right_open}
+	};
+	auto const bytes = write(intervals);
+	BOOST_REQUIRE_EQUAL(bytes.size(), 64u + 12u);
+	BOOST_CHECK_EQUAL(bytes.substr(0, 8), "EZINTRVL");
+	BOOST_CHECK_EQUAL(bytes[8], 1);
+	BOOST_CHECK_EQUAL(bytes[12], 3);
+	BOOST_CHECK_EQUAL(bytes[13], 4);
+	BOOST_CHECK_EQUAL(bytes[14], 1);
+	BOOST_CHECK_EQUAL(bytes[16], 1);
+	BOOST_CHECK_EQUAL(bytes[24], 12);
+
+	// Little-endian bounds followed by the openness
+	BOOST_CHECK_EQUAL(bytes.substr(64, 12), std::string("\xff\xff\xff\xff\x04\x03\x02\x01\x02\0\0\0",
+	                                                    12));
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip) {
+	auto const intervals = sample(1500);
+	auto const bytes = write(intervals);
+	BOOST_CHECK_EQUAL(bytes.size(), 64 + intervals.size() * 3 * sizeof(double));
+
+	ez::interval_view<ez::interval<double>> const view{bytes.data(), bytes.size()};
+	BOOST_REQUIRE_EQUAL(view.size(), intervals.size());
+	for(std::size_t i = 0; i < intervals.size(); ++i) {
+		BOOST_CHECK_EQUAL(view[i], intervals[i]);
+	}
+
+	ez::interval_view<ez::interval<double>> const empty;
+	BOOST_CHECK(empty.empty());
+}
+
+BOOST_AUTO_TEST_CASE(BasicInterval) {
+	std::vector<ez::ropen_interval<std::int64_t>> const intervals = {
+		ez::make_interval[std::int64_t{0}](std::int64_t{10}),
+		ez::make_interval[std::int64_t{-5}](std::int64_t{5})
+	};
+	auto const bytes = write(intervals);
+	BOOST_CHECK_EQUAL(bytes.size(), 64 + intervals.size() * 2 * sizeof(std::int64_t));
+
+	ez::interval_view<ez::ropen_interval<std::int64_t>> const view{bytes.data(), bytes.size()};
+	BOOST_REQUIRE_EQUAL(view.size(), intervals.size());
+	BOOST_CHECK_EQUAL(view[0], intervals[0]);
+	BOOST_CHECK_EQUAL(view[1], intervals[1]);
+
+	// A file of basic_interval can be read as interval, but not as a different basic_interval
+	ez::interval_view<ez::interval<std::int64_t>> const general{bytes.data(), bytes.size()};
+	BOOST_CHECK_EQUAL(general[1], intervals[1]);
+	typedef ez::interval_view<ez::closed_interval<std::int64_t>> closed_view;
+	BOOST_CHECK_THROW(closed_view(bytes.data(), bytes.size()), ez::invalid_interval_file);
+}
+
+BOOST_AUTO_TEST_CASE(Invalid) {
+	typedef ez::interval_view<ez::interval<double>> view;
+	auto const bytes = write(sample(10));
+	BOOST_CHECK_NO_THROW(view(bytes.data(), bytes.size()));
+
+	// Truncated
+	BOOST_CHECK_THROW(view(bytes.data(), 63), ez::invalid_interval_file);
+	BOOST_CHECK_THROW(view(bytes.data(), bytes.size() - 1), ez::invalid_interval_file);
+
+	// Wrong magic, version or type
+	for(std::size_t offset : {0u, 8u, 12u, 13u, 14u, 24u}) {
+		auto copy = bytes;
+		copy[offset] = static_cast<char>(copy[offset] + 1);
+		BOOST_CHECK_THROW(view(copy.data(), copy.size()), ez::invalid_interval_file);
+	}
+
+	typedef ez::interval_view<ez::interval<float>> float_view;
+	BOOST_CHECK_THROW(float_view(bytes.data(), bytes.size()), ez::invalid_interval_file);
+}
+
+BOOST_AUTO_TEST_CASE(Mapped) {
+	auto const intervals = sample(5000);
+	std::string const path = "interval_file_test.bin";
+	{
+		std::ofstream out{path, std::ios::binary};
+		ez::write_intervals(out, intervals.data(), intervals.size());
+	}
+
+	{
+		ez::mapped_intervals<ez::interval<double>> const mapped{path};
+		BOOST_REQUIRE_EQUAL(mapped.size(), intervals.size());
+		for(std::size_t i = 0; i < intervals.size(); ++i) {
+			BOOST_CHECK_EQUAL(mapped[i], intervals[i]);
+		}
+	}
+
+	{
+		std::ofstream out{path, std::ios::binary | std::ios::trunc};
+	}
+	BOOST_CHECK_THROW(ez::mapped_intervals<ez::interval<double>>{path}, ez::invalid_interval_file);
+	std::remove(path.c_str());
+
+	BOOST_CHECK_THROW(ez::mapped_file{"no/such/file.bin"}, std::system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
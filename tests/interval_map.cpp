@@ -0,0 +1,168 @@
+#include "ez/interval_map.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Checks m against a value for every integer key in [0, expected.size()), where 0 means no value
+template <typename K, typename Combine>
+void check_map(ez::interval_map<K, int, Combine> const& m, std::vector<int> const& expected) {
+	for(std::size_t i = 0; i + 1 < m.size(); ++i) {
+		BOOST_CHECK(m.range(i).upper() <= m.range(i + 1).lower());
+		BOOST_CHECK(m.range(i).upper() < m.range(i + 1).lower() || m.value(i) != m.value(i + 1));
+	}
+
+	BOOST_CHECK(m.find(static_cast<K>(-1)) == nullptr);
+	BOOST_CHECK(m.find(static_cast<K>(expected.size())) == nullptr);
+	for(std::size_t key = 0; key < expected.size(); ++key) {
+		auto const found = m.find(static_cast<K>(key));
+		if(expected[key] == 0) {
+			BOOST_CHECK(found == nullptr);
+		} else {
+			BOOST_REQUIRE(found != nullptr);
+			BOOST_CHECK_EQUAL(*found, expected[key]);
+		}
+	}
+}
+
+template <typename K, typename Combine, typename Expected>
+void check_random(Combine combine, Expected update) {
+	std::mt19937 engine{17};
+	std::uniform_int_distribution<int> key{0, 999};
+	std::uniform_int_distribution<int> value{1, 4};
+	ez::interval_map<K, int, Combine> m{combine};
+	std::vector<int> expected(1000, 0);
+	for(int round = 0; round < 500; ++round) {
+		auto a = key(engine);
+		auto b = key(engine);
+		if(a == b) {
+			continue;
+		}
+		if(b < a) {
+			std::swap(a, b);
+		}
+
+		auto const v = value(engine);
+		m.insert({static_cast<K>(a), static_cast<K>(b)}, v);
+		for(auto i = a; i < b; ++i) {
+			expected[i] = (expected[i] == 0) ? v : update(expected[i], v);
+		}
+		if(round % 50 == 0) {
+			check_map(m, expected);
+		}
+	}
+	check_map(m, expected);
+}
+
+// Checks that inserting random batches with insert(first, last) gives the same segments as
+// inserting each interval on its own
+template <typename Combine>
+void check_batches(Combine combine) {
+	std::mt19937 engine{23};
+	std::uniform_int_distribution<int> key{0, 199};
+	std::uniform_int_distribution<int> value{1, 4};
+	ez::interval_map<int, int, Combine> one{combine};
+	ez::interval_map<int, int, Combine> batched{combine};
+	for(int round = 0; round < 50; ++round) {
+		std::vector<std::pair<ez::ropen_interval<int>, int>> batch;
+		for(auto n = key(engine) % 20; n > 0; --n) {
+			auto a = key(engine);
+			auto b = key(engine);
+			if(a == b) {
+				continue;
+			}
+			if(b < a) {
+				std::swap(a, b);
+			}
+			batch.emplace_back(ez::ropen_interval<int>{a, b}, value(engine));
+			one.insert(batch.back().first, batch.back().second);
+		}
+		batched.insert(batch.begin(), batch.end());
+
+		BOOST_REQUIRE_EQUAL(batched.size(), one.size());
+		for(std::size_t i = 0; i < one.size(); ++i) {
+			BOOST_CHECK_EQUAL(batched.range(i), one.range(i));
+			BOOST_CHECK_EQUAL(batched.value(i), one.value(i));
+		}
+		for(int k = -1; k <= 200; ++k) {
+			auto const found = batched.find(k);
+			BOOST_REQUIRE_EQUAL(found == nullptr, one.find(k) == nullptr);
+			if(found) {
+				BOOST_CHECK_EQUAL(*found, *one.find(k));
+			}
+		}
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(interval_map)
+
+BOOST_AUTO_TEST_CASE(Insert) {
+	ez::interval_map<int, int> m;
+	BOOST_CHECK(m.empty());
+	BOOST_CHECK(m.find(0) == nullptr);
+
+	m.insert(ez::make_interval[0](10), 1);
+	m.insert(ez::make_interval[5](15), 2);
+	BOOST_REQUIRE_EQUAL(m.size(), 3u);
+	BOOST_CHECK_EQUAL(m.range(0), ez::make_interval[0](5));
+	BOOST_CHECK_EQUAL(m.range(1), ez::make_interval[5](10));
+	BOOST_CHECK_EQUAL(m.range(2), ez::make_interval[10](15));
+	BOOST_CHECK_EQUAL(m.value(1), 3);
+	BOOST_CHECK_EQUAL(*m.find(7), 3);
+	BOOST_CHECK(m.find(15) == nullptr);
+	BOOST_CHECK(!m.contains(-1));
+
+	// Equal neighbours are joined
+	m.insert(ez::make_interval[15](20), 2);
+	BOOST_REQUIRE_EQUAL(m.size(), 3u);
+	BOOST_CHECK_EQUAL(m.range(2), ez::make_interval[10](20));
+
+	// The gap between segments is filled
+	m.insert(ez::make_interval[25](30), 1);
+	m.insert(ez::make_interval[18](27), 1);
+	BOOST_REQUIRE_EQUAL(m.size(), 7u);
+	BOOST_CHECK_EQUAL(m.range(3), ez::make_interval[18](20));
+	BOOST_CHECK_EQUAL(m.value(3), 3);
+	BOOST_CHECK_EQUAL(m.range(4), ez::make_interval[20](25));
+	BOOST_CHECK_EQUAL(m.value(4), 1);
+	BOOST_CHECK_EQUAL(m.range(5), ez::make_interval[25](27));
+	BOOST_CHECK_EQUAL(m.value(5), 2);
+
+	m.clear();
+	BOOST_CHECK(m.empty());
+}
+
+BOOST_AUTO_TEST_CASE(MatchesBruteForce) {
+	check_random<int>(std::plus<int>{}, [](int a, int b){ return a + b; });
+	check_random<std::int64_t>(ez::maximum{}, [](int a, int b){ return std::max(a, b); });
+	check_random<double>(ez::replace{}, [](int, int b){ return b; });
+	check_random<float>(ez::maximum{}, [](int a, int b){ return std::max(a, b); });
+	check_random<unsigned>(ez::replace{}, [](int, int b){ return b; });
+}
+
+BOOST_AUTO_TEST_CASE(InsertBatch) {
+	std::vector<std::pair<ez::ropen_interval<int>, int>> const batch = {
+		{ez::make_interval[0](10), 1}, {ez::make_interval[5](15), 2}, {ez::make_interval[15](20), 2}
+	};
+	ez::interval_map<int, int> const m{batch.begin(), batch.end()};
+	BOOST_REQUIRE_EQUAL(m.size(), 3u);
+	BOOST_CHECK_EQUAL(m.range(0), ez::make_interval[0](5));
+	BOOST_CHECK_EQUAL(m.range(1), ez::make_interval[5](10));
+	BOOST_CHECK_EQUAL(m.value(1), 3);
+	BOOST_CHECK_EQUAL(m.range(2), ez::make_interval[10](20));
+	BOOST_CHECK_EQUAL(*m.find(17), 2);
+
+	check_batches(std::plus<int>{});
+	check_batches(ez::replace{});
+	check_batches(ez::maximum{});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
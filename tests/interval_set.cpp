@@ -0,0 +1,113 @@
+#include "ez/interval_set.hpp"
+#include "ostream.hpp"
+#include "random_interval.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Random intervals with bounds in [0, 20] and random openness
+std::vector<ez::interval<double>> random_intervals(std::size_t n, std::mt19937& engine) {
+	std::vector<ez::interval<double>> result;
+	while(result.size() < n) {
+		result.push_back(test::random_interval<double>(engine, 20));
+	}
+	return result;
+}
+
+bool any_contains(std::vector<ez::interval<double>> const& intervals, double x) {
+	return std::any_of(intervals.begin(), intervals.end(),
+	                   [x](ez::interval<double> const& r){ return contains(r, x); });
+}
+
+// Checks that s is sorted, disjoint and does not have touching intervals
+void check_canonical(ez::interval_set<double> const& s) {
+	for(auto it = s.begin(); it != s.end() && std::next(it) != s.end(); ++it) {
+		auto const next = *std::next(it);
+		BOOST_CHECK(it->upper() < next.lower() ||
+		            (it->upper() == next.lower() && it->right_open() && next.left_open()));
+	}
+}
+
+// Every boundary is a multiple of 1, so checking multiples of 0.5 covers every open and closed end
+template <typename Expected>
+void check_members(ez::interval_set<double> const& s, Expected expected) {
+	check_canonical(s);
+	for(auto x = -1.0; x <= 21.0; x += 0.5) {
+		BOOST_CHECK_EQUAL(s.contains(x), expected(x));
+		BOOST_CHECK_EQUAL(std::any_of(s.begin(), s.end(), [x](ez::interval<double> const& r) {
+			return contains(r, x);
+		}), expected(x));
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(interval_set)
+
+BOOST_AUTO_TEST_CASE(InsertErase) {
+	ez::interval_set<int> s = {ez::make_interval[5](8), ez::make_interval[0](2)};
+	BOOST_CHECK_EQUAL(s.size(), 2u);
+	s.insert(ez::make_interval[2][5]);
+	BOOST_REQUIRE_EQUAL(s.size(), 1u);
+	BOOST_CHECK_EQUAL(*s.begin(), ez::make_interval[0](8));
+
+	s.erase(ez::make_interval(3)(4));
+	BOOST_REQUIRE_EQUAL(s.size(), 2u);
+	BOOST_CHECK_EQUAL(s.begin()[0], ez::make_interval[0][3]);
+	BOOST_CHECK_EQUAL(s.begin()[1], ez::make_interval[4](8));
+
+	// Open ends at the same value do not touch
+	s.insert(ez::make_interval(8)[9]);
+	BOOST_CHECK_EQUAL(s.size(), 3u);
+	BOOST_CHECK(!s.contains(8));
+	s.insert(ez::make_interval[8][8]);
+	BOOST_REQUIRE_EQUAL(s.size(), 2u);
+	BOOST_CHECK_EQUAL(s.begin()[1], ez::make_interval[4][9]);
+
+	s.erase(ez::make_interval[0][9]);
+	BOOST_CHECK(s.empty());
+}
+
+BOOST_AUTO_TEST_CASE(MatchesMembership) {
+	std::mt19937 engine{7};
+	for(int round = 0; round < 200; ++round) {
+		auto const a = random_intervals(round % 7, engine);
+		auto const b = random_intervals(round % 5, engine);
+		auto const erased = random_intervals(2, engine);
+
+		ez::interval_set<double> const bulk(a.begin(), a.end());
+		check_members(bulk, [&](double x){ return any_contains(a, x); });
+
+		ez::interval_set<double> inserted;
+		for(auto const& r : a) {
+			inserted.insert(r);
+		}
+		BOOST_CHECK(inserted == bulk);
+
+		for(auto const& r : erased) {
+			inserted.erase(r);
+		}
+		check_members(inserted, [&](double x){
+			return any_contains(a, x) && !any_contains(erased, x);
+		});
+
+		ez::interval_set<double> const other(b.begin(), b.end());
+		check_members(bulk | other, [&](double x){ return any_contains(a, x) || any_contains(b, x); });
+		check_members(bulk & other, [&](double x){ return any_contains(a, x) && any_contains(b, x); });
+		check_members(bulk - other, [&](double x){ return any_contains(a, x) && !any_contains(b, x); });
+		check_members(bulk ^ other, [&](double x){ return any_contains(a, x) != any_contains(b, x); });
+
+		auto copy = bulk;
+		copy |= other;
+		BOOST_CHECK(copy == (bulk | other));
+		copy -= other;
+		BOOST_CHECK(copy == (bulk - other));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+#include "ez/interval_tree.hpp"
+#include "ostream.hpp"
+#include "random_interval.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(interval_tree)
+
+BOOST_AUTO_TEST_CASE(Queries) {
+	ez::interval_tree<int, std::string> tree;
+	BOOST_CHECK(tree.empty());
+	tree.insert(ez::make_interval[0](10), "a");
+	auto const b = tree.insert(ez::make_interval(5)[20], "b");
+	tree.insert(ez::make_interval[10][10], "c");
+	BOOST_CHECK_EQUAL(tree.size(), 3u);
+	BOOST_CHECK_EQUAL(tree.range(b), ez::make_interval(5)[20]);
+	BOOST_CHECK_EQUAL(tree.value(b), "b");
+
+	std::string found;
+	auto const append = [&](ez::interval<int> const&, std::string const& s){ found += s; };
+	tree.containing(7, append);
+	BOOST_CHECK_EQUAL(found, "ab");
+
+	found.clear();
+	tree.containing(5, append);
+	BOOST_CHECK_EQUAL(found, "a");
+
+	found.clear();
+	tree.containing(10, append);
+	BOOST_CHECK_EQUAL(found, "bc");
+
+	found.clear();
+	tree.overlapping(ez::make_interval(-5)[0], append);
+	BOOST_CHECK_EQUAL(found, "a");
+
+	found.clear();
+	tree.overlapping(ez::make_interval(20)[30], append);
+	BOOST_CHECK_EQUAL(found, "");
+
+	tree.erase(b);
+	BOOST_CHECK_EQUAL(tree.size(), 2u);
+	found.clear();
+	tree.overlapping(ez::make_interval[0][20], append);
+	BOOST_CHECK_EQUAL(found, "ac");
+
+	// The slot of b is reused
+	BOOST_CHECK_EQUAL(tree.insert(ez::make_interval[1][2], "d"), b);
+	tree.clear();
+	BOOST_CHECK(tree.empty());
+	found.clear();
+	tree.containing(1, append);
+	BOOST_CHECK_EQUAL(found, "");
+}
+
+BOOST_AUTO_TEST_CASE(MatchesBruteForce) {
+	std::mt19937 engine{11};
+	ez::interval_tree<int, int> tree;
+	std::vector<std::pair<ez::interval<int>, ez::interval_tree<int, int>::handle>> stored;
+
+	int next = 0;
+	for(int round = 0; round < 2000; ++round) {
+		if(stored.empty() || engine() % 3 != 0) {
+			auto const r = test::random_interval<int>(engine, 50);
+			stored.emplace_back(r, tree.insert(r, next));
+			++next;
+		} else {
+			auto const i = engine() % stored.size();
+			tree.erase(stored[i].second);
+			stored.erase(stored.begin() + i);
+		}
+		BOOST_REQUIRE_EQUAL(tree.size(), stored.size());
+
+		auto const query = test::random_interval<int>(engine, 50);
+		std::vector<int> expected;
+		std::vector<int> actual;
+		for(auto const& s : stored) {
+			if(test::overlaps(s.first, query)) {
+				expected.push_back(tree.value(s.second));
+			}
+		}
+		tree.overlapping(query, [&](ez::interval<int> const& r, int value) {
+			BOOST_CHECK(test::overlaps(r, query));
+			actual.push_back(value);
+		});
+		std::sort(expected.begin(), expected.end());
+		std::sort(actual.begin(), actual.end());
+		BOOST_CHECK(expected == actual);
+
+		expected.clear();
+		actual.clear();
+		auto const x = query.lower();
+		for(auto const& s : stored) {
+			if(contains(s.first, x)) {
+				expected.push_back(tree.value(s.second));
+			}
+		}
+		tree.containing(x, [&](ez::interval<int> const&, int value) {
+			actual.push_back(value);
+		});
+		std::sort(expected.begin(), expected.end());
+		std::sort(actual.begin(), actual.end());
+		BOOST_CHECK(expected == actual);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(EraseReleasesValue) {
+	ez::interval_tree<int, std::shared_ptr<int>> tree;
+	auto const value = std::make_shared<int>(1);
+	auto const a = tree.insert(ez::make_interval[0](10), value);
+	tree.insert(ez::make_interval[5](15), value);
+	BOOST_CHECK_EQUAL(value.use_count(), 3);
+
+	tree.erase(a);
+	BOOST_CHECK_EQUAL(value.use_count(), 2);
+
+	// The slot is reused by the next insert
+	tree.insert(ez::make_interval[1](2), std::make_shared<int>(2));
+	BOOST_CHECK_EQUAL(value.use_count(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+#include "ez/maybe_interval.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace {
+
+static_assert(ez::maybe_interval<int>{}.empty(), "");
+static_assert(ez::maybe_interval<int>{3, 3, ez::right_open}.empty(), "");
+static_assert(ez::maybe_interval<int>{4, 2, ez::closed}.empty(), "");
+static_assert(!ez::maybe_interval<int>{3, 3, ez::closed}.empty(), "");
+static_assert(!contains(ez::maybe_interval<int>{4, 2, ez::closed}, 3), "");
+static_assert(contains(ez::maybe_interval<int>{ez::make_interval[2](4)}, 3), "");
+
+}
+
+BOOST_AUTO_TEST_SUITE(maybe_interval)
+
+BOOST_AUTO_TEST_CASE(Empty) {
+	ez::maybe_interval<int> const a;
+	BOOST_CHECK(a.empty());
+	BOOST_CHECK_THROW(a.value(), ez::empty_interval);
+	BOOST_CHECK_EQUAL(a.size(), 0);
+	BOOST_CHECK(a.begin() == a.end());
+	BOOST_CHECK(!contains(a, 0));
+
+	ez::maybe_interval<int> const b{5, 2, ez::closed};
+	BOOST_CHECK(b.empty());
+	BOOST_CHECK_EQUAL(b.size(), 0);
+	BOOST_CHECK(b.begin() == b.end());
+	BOOST_CHECK_EQUAL(a, b);
+
+	ez::maybe_interval<double> const c{1.0, 0.0, ez::open};
+	BOOST_CHECK(c.begin() == c.end());
+}
+
+BOOST_AUTO_TEST_CASE(NotEmpty) {
+	ez::maybe_interval<int> const a = ez::make_interval[1](4);
+	BOOST_CHECK(!a.empty());
+	BOOST_CHECK_EQUAL(a.value(), ez::make_interval[1](4));
+	BOOST_CHECK_EQUAL(a.size(), 3);
+	BOOST_CHECK_EQUAL_COLLECTIONS(a.begin(), a.end(), ez::make_interval[1](4).begin(),
+	                              ez::make_interval[1](4).end());
+	BOOST_CHECK(contains(a, 1));
+	BOOST_CHECK(!contains(a, 4));
+	BOOST_CHECK_NE(a, ez::maybe_interval<int>{});
+}
+
+BOOST_AUTO_TEST_CASE(Intersection) {
+	auto const window = ez::maybe_interval<int>{ez::make_interval[0](10)};
+	BOOST_CHECK_EQUAL(intersection(window, ez::make_interval[5](20)),
+	                  ez::maybe_interval<int>{ez::make_interval[5](10)});
+	BOOST_CHECK_EQUAL(intersection(ez::make_interval(5)[20], window),
+	                  ez::maybe_interval<int>{ez::make_interval(5)(10)});
+	BOOST_CHECK(intersection(window, ez::make_interval[10][20]).empty());
+	BOOST_CHECK(intersection(window, ez::make_interval[20][30]).empty());
+	BOOST_CHECK(intersection(window, ez::maybe_interval<int>{}).empty());
+	BOOST_CHECK(intersection(ez::maybe_interval<int>{}, ez::make_interval[-5][5]).empty());
+
+	// Agrees with ez::intersection whenever that does not throw
+	std::vector<ez::interval<int>> all;
+	for(int lower = 0; lower < 4; ++lower) {
+		for(int upper = lower; upper < 4; ++upper) {
+			for(auto o : {ez::closed, ez::left_open, ez::right_open, ez::open}) {
+				if(lower < upper || o == ez::closed) {
+					all.push_back(ez::interval<int>{lower, upper, o});
+				}
+			}
+		}
+	}
+	for(auto const& l : all) {
+		for(auto const& r : all) {
+			auto const maybe = intersection(ez::maybe_interval<int>{l}, r);
+			try {
+				auto const expected = intersection(l, r);
+				BOOST_REQUIRE(!maybe.empty());
+				BOOST_CHECK_EQUAL(maybe.value(), expected);
+			} catch(ez::empty_interval const&) {
+				BOOST_CHECK(maybe.empty());
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Subset) {
+	auto const a = ez::maybe_interval<int>{ez::make_interval[2](4)};
+	ez::maybe_interval<int> const empty;
+	BOOST_CHECK(subset(a, ez::make_interval[0][5]));
+	BOOST_CHECK(subset(a, ez::make_interval[2](4)));
+	BOOST_CHECK(!subset(a, ez::make_interval(2)(4)));
+	BOOST_CHECK(subset(empty, ez::make_interval[0][5]));
+	BOOST_CHECK(subset(empty, empty));
+	BOOST_CHECK(!subset(a, empty));
+	BOOST_CHECK(superset(ez::make_interval[0][5], a));
+	BOOST_CHECK(superset(a, empty));
+}
+
+BOOST_AUTO_TEST_CASE(Arithmetic) {
+	ez::maybe_interval<int> const a = ez::make_interval[1](4);
+	ez::maybe_interval<int> const b = ez::make_interval(0)[2];
+	ez::maybe_interval<int> const empty;
+	BOOST_CHECK_EQUAL(a + b, ez::maybe_interval<int>{ez::make_interval(1)(6)});
+	BOOST_CHECK_EQUAL(a - b, ez::maybe_interval<int>{ez::make_interval[-1](4)});
+	BOOST_CHECK((a + empty).empty());
+	BOOST_CHECK((empty - a).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
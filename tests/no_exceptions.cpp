@@ -0,0 +1,66 @@
+// Built with -fno-exceptions and EZ_NO_EXCEPTIONS to check that every header compiles without
+// exceptions and that the functions in ez/checked.hpp report errors without them.
+
+#include "ez/checked.hpp"
+#include "ez/chunk.hpp"
+#include "ez/compact_interval.hpp"
+#include "ez/concurrent_interval_tree.hpp"
+#include "ez/contains_bulk.hpp"
+#include "ez/direct_iterator.hpp"
+#include "ez/discrete_interval.hpp"
+#include "ez/flat_index.hpp"
+#include "ez/grouped_intervals.hpp"
+#include "ez/interval.hpp"
+#include "ez/interval_array.hpp"
+#include "ez/interval_file.hpp"
+#include "ez/interval_map.hpp"
+#include "ez/interval_set.hpp"
+#include "ez/interval_tree.hpp"
+#include "ez/maybe_interval.hpp"
+#include "ez/parallel.hpp"
+#include "ez/partition_index.hpp"
+#include "ez/rounding.hpp"
+#include "ez/simd.hpp"
+#include "ez/split.hpp"
+#include "ez/static_interval_index.hpp"
+#include "ez/static_partition.hpp"
+#include "ez/stride.hpp"
+#include "ez/unchecked.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, char const* expression) {
+	if(!condition) {
+		std::fprintf(stderr, "check failed: %s\n", expression);
+		++failures;
+	}
+}
+
+}
+
+#define CHECK(x) check((x), #x)
+
+int main() {
+	auto const r = ez::try_interval(0, 10, false, true);
+	CHECK(r.has_value());
+	CHECK(!ez::try_interval(3, 3, ez::open));
+
+	auto const a = ez::try_interval(1.0, 2.0, ez::closed).value();
+	CHECK(ez::checked_div(a, ez::make_interval[-1.0][1.0]).error() == ez::errc::divide_by_zero);
+	CHECK(ez::checked_mul(a, a).value() == ez::make_interval[1.0][4.0]);
+	CHECK(a + ez::make_interval[1.0][1.0] == ez::make_interval[2.0][3.0]);
+	CHECK(intersection(ez::maybe_interval<double>{a}, ez::make_interval[3.0][4.0]).empty());
+
+	std::atomic<int> total{0};
+	ez::parallel_for(*r, [&](int i) {
+		total += i;
+	});
+	CHECK(total == 45);
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include "ez/parallel.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(parallel)
+
+BOOST_AUTO_TEST_CASE(TaskGroup) {
+	ez::thread_pool pool{3};
+	BOOST_CHECK_EQUAL(pool.size(), 3u);
+
+	std::atomic<int> count{0};
+	ez::task_group group{pool};
+	for(int i = 0; i < 100; ++i) {
+		group.run([&count]{ ++count; });
+	}
+	group.wait();
+	BOOST_CHECK_EQUAL(count.load(), 100);
+
+	group.run([]{ throw std::runtime_error{"task"}; });
+	BOOST_CHECK_THROW(group.wait(), std::runtime_error);
+
+	// The group can be reused after an exception
+	group.run([&count]{ ++count; });
+	group.wait();
+	BOOST_CHECK_EQUAL(count.load(), 101);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelFor) {
+	for(std::size_t threads : {0, 1, 4}) {
+		ez::thread_pool pool{threads};
+		for(std::ptrdiff_t grain : {0, 1, 7, 1000}) {
+			std::vector<int> visits(10000);
+			ez::parallel_for(pool, ez::indices(visits), [&visits](std::size_t i) {
+				++visits[i];
+			}, grain);
+			BOOST_CHECK(std::all_of(visits.begin(), visits.end(), [](int v){ return v == 1; }));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Intervals) {
+	ez::thread_pool pool{2};
+
+	std::atomic<long> sum{0};
+	ez::parallel_for(pool, ez::make_interval(0)[100], [&sum](int i){ sum += i; });
+	BOOST_CHECK_EQUAL(sum.load(), 5050);
+
+	sum = 0;
+	ez::parallel_for(pool, ez::interval<int>{-10, 10, ez::open}, [&sum](int i){ sum += i; }, 3);
+	BOOST_CHECK_EQUAL(sum.load(), 0);
+
+	std::vector<int> vec(1000);
+	ez::parallel_for(pool, ez::iterate(vec), [](std::vector<int>::iterator it){ *it = 2; });
+	BOOST_CHECK_EQUAL(std::accumulate(vec.begin(), vec.end(), 0), 2000);
+
+	sum = 0;
+	ez::parallel_for(ez::make_interval[1][10], [&sum](int i){ sum += i; });
+	BOOST_CHECK_EQUAL(sum.load(), 55);
+}
+
+BOOST_AUTO_TEST_CASE(Nested) {
+	ez::thread_pool pool{3};
+	std::atomic<long> sum{0};
+	ez::parallel_for(pool, ez::make_interval[0](50), [&](int i) {
+		ez::parallel_for(pool, ez::make_interval[0](50), [&](int j){ sum += i * j; }, 4);
+	}, 2);
+	BOOST_CHECK_EQUAL(sum.load(), 1225L * 1225L);
+}
+
+BOOST_AUTO_TEST_CASE(Exceptions) {
+	ez::thread_pool pool{3};
+	std::atomic<int> count{0};
+	BOOST_CHECK_THROW(ez::parallel_for(pool, ez::make_interval[0](10000), [&count](int i) {
+		++count;
+		if(i == 5000) {
+			throw std::logic_error{"5000"};
+		}
+	}, 10), std::logic_error);
+	BOOST_CHECK(count.load() <= 10000);
+
+	// The pool is still usable afterwards
+	count = 0;
+	ez::parallel_for(pool, ez::make_interval[0](100), [&count](int){ ++count; });
+	BOOST_CHECK_EQUAL(count.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(Reduce) {
+	ez::thread_pool pool{3};
+	BOOST_CHECK_EQUAL(ez::parallel_reduce(pool, ez::make_interval[1][100000], 0LL,
+	                                      std::plus<long long>{}), 5000050000LL);
+	BOOST_CHECK_EQUAL(ez::parallel_reduce(pool, ez::make_interval[1][10], 5, std::plus<int>{}, 3),
+	                  60);
+	BOOST_CHECK_EQUAL(ez::parallel_reduce(pool, ez::make_interval(0)(1), 7, std::plus<int>{}), 7);
+	BOOST_CHECK_EQUAL(ez::parallel_reduce(ez::make_interval[1][5], 1, std::multiplies<int>{}), 120);
+
+	// The operation does not need to be commutative
+	auto const concatenate = [](std::string const& a, std::string const& b){ return a + b; };
+	auto const to_string = [](int i){ return std::string(1, static_cast<char>('a' + i)); };
+	BOOST_CHECK_EQUAL(ez::parallel_transform_reduce(pool, ez::make_interval[0](26), std::string{},
+	                                                concatenate, to_string, 2),
+	                  "abcdefghijklmnopqrstuvwxyz");
+
+	std::vector<int> vec = {1, 2, 3, 4};
+	BOOST_CHECK_EQUAL(ez::parallel_transform_reduce(pool, ez::iterate(vec), 0, std::plus<int>{},
+	                                                [](std::vector<int>::iterator it){ return *it; },
+	                                                1),
+	                  10);
+}
+
+BOOST_AUTO_TEST_CASE(DeterministicReduce) {
+	// Terms of very different magnitudes, so the sum depends on the order of the additions
+	auto const term = [](int i){ return (i % 3 == 0 ? 1e16 : 1.0) / (i + 1); };
+	auto const r = ez::make_interval[0](100000);
+
+	ez::thread_pool serial{0};
+	auto const expected = ez::parallel_transform_reduce(serial, r, 0.0, std::plus<double>{}, term,
+	                                                    100);
+	for(std::size_t threads : {1, 2, 7}) {
+		ez::thread_pool pool{threads};
+		for(int repeat = 0; repeat < 5; ++repeat) {
+			auto const result = ez::parallel_transform_reduce(pool, r, 0.0, std::plus<double>{},
+			                                                  term, 100);
+			BOOST_CHECK_EQUAL(std::memcmp(&result, &expected, sizeof(double)), 0);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Transform) {
+	auto const square = [](int i){ return i * i; };
+	for(std::size_t threads : {0, 1, 4}) {
+		ez::thread_pool pool{threads};
+		for(std::ptrdiff_t block_size : {0, 1, 3, 10000}) {
+			for(std::size_t blocks_in_flight : {0, 1, 2, 5}) {
+				std::vector<int> result;
+				ez::parallel_transform(pool, ez::make_interval[0](1000), std::back_inserter(result),
+				                       square, block_size, blocks_in_flight);
+				BOOST_REQUIRE_EQUAL(result.size(), 1000u);
+				for(auto i : ez::indices(result)) {
+					BOOST_CHECK_EQUAL(result[i], static_cast<int>(i * i));
+				}
+			}
+		}
+	}
+
+	std::ostringstream stream;
+	auto const to_string = [](int i){ return std::to_string(i) + ","; };
+	ez::parallel_transform(ez::make_interval(0)[5], std::ostream_iterator<std::string>(stream),
+	                       to_string, 2);
+	BOOST_CHECK_EQUAL(stream.str(), "1,2,3,4,5,");
+
+	std::vector<int> empty;
+	auto const out = ez::parallel_transform(ez::make_interval(0)(1), std::back_inserter(empty),
+	                                        square);
+	static_cast<void>(out);
+	BOOST_CHECK(empty.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TransformExceptions) {
+	ez::thread_pool pool{2};
+	std::vector<int> result;
+	BOOST_CHECK_THROW(ez::parallel_transform(pool, ez::make_interval[0](1000),
+	                                         std::back_inserter(result), [](int i) {
+		if(i == 500) {
+			throw std::logic_error{"500"};
+		}
+		return i;
+	}, 10, 3), std::logic_error);
+
+	// Blocks are written in order, so nothing after the block that threw was written
+	BOOST_CHECK(result.size() <= 500u);
+	for(auto i : ez::indices(result)) {
+		BOOST_CHECK_EQUAL(result[i], static_cast<int>(i));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
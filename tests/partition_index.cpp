@@ -0,0 +1,63 @@
+#include "ez/partition_index.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(partition_index)
+
+BOOST_AUTO_TEST_CASE(Bucket) {
+	ez::partition_index<int> const brackets = {ez::make_interval[0](100),
+	                                           ez::make_interval[100](500),
+	                                           ez::make_interval[500](1000)};
+	BOOST_CHECK_EQUAL(brackets.size(), 3u);
+	BOOST_CHECK_EQUAL(brackets[1], ez::make_interval[100](500));
+	BOOST_CHECK_EQUAL(brackets.bucket(-1), 3u);
+	BOOST_CHECK_EQUAL(brackets.bucket(0), 0u);
+	BOOST_CHECK_EQUAL(brackets.bucket(99), 0u);
+	BOOST_CHECK_EQUAL(brackets.bucket(100), 1u);
+	BOOST_CHECK_EQUAL(brackets.bucket(999), 2u);
+	BOOST_CHECK_EQUAL(brackets.bucket(1000), 3u);
+
+	ez::partition_index<int> const empty;
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK_EQUAL(empty.bucket(0), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Invalid) {
+	BOOST_CHECK_THROW((ez::partition_index<int>{ez::make_interval[0](1), ez::make_interval[2](3)}),
+	                  ez::invalid_partition);
+	BOOST_CHECK_THROW((ez::partition_index<int>{ez::make_interval[0](2), ez::make_interval[1](3)}),
+	                  ez::invalid_partition);
+	BOOST_CHECK_THROW((ez::partition_index<int>{ez::make_interval[1](2), ez::make_interval[0](1)}),
+	                  ez::invalid_partition);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesLinearSearch) {
+	// Enough intervals for the index to have several levels
+	for(int bins : {1, 15, 16, 17, 300, 5000}) {
+		std::vector<ez::ropen_interval<double>> intervals;
+		for(int i = 0; i < bins; ++i) {
+			intervals.push_back(ez::make_interval[2.0 * i](2.0 * i + 2.0));
+		}
+		ez::partition_index<double> const index(intervals.begin(), intervals.end());
+		BOOST_REQUIRE_EQUAL(index.size(), intervals.size());
+
+		std::vector<double> values;
+		for(double x = -1.0; x <= 2.0 * bins + 1.0; x += 0.5) {
+			values.push_back(x);
+		}
+		std::vector<std::size_t> out(values.size());
+		index.buckets(values.data(), values.size(), out.data());
+		for(std::size_t i = 0; i < values.size(); ++i) {
+			std::size_t expected = 0;
+			while(expected < intervals.size() && !contains(intervals[expected], values[i])) {
+				++expected;
+			}
+			BOOST_CHECK_EQUAL(out[i], expected);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,47 @@
+#ifndef INCLUDE_GUARD_C755E3B2_1B36_4B59_A0D8_61731B0226B8
+#define INCLUDE_GUARD_C755E3B2_1B36_4B59_A0D8_61731B0226B8
+
+#include "ez/interval.hpp"
+
+#include <random>
+#include <utility>
+
+// Helpers shared by the tests that compare the interval containers against brute force
+namespace test {
+
+// Returns an interval with whole number bounds in [0, max] and random openness, except that an
+// interval whose bounds are equal is always closed
+template <typename T>
+ez::interval<T> random_interval(std::mt19937& engine, int max) {
+	std::uniform_int_distribution<int> value{0, max};
+	std::uniform_int_distribution<int> open{0, 3};
+	auto a = value(engine);
+	auto b = value(engine);
+	if(b < a) {
+		std::swap(a, b);
+	}
+	return {static_cast<T>(a), static_cast<T>(b),
+	        static_cast<ez::openness>(a == b ? 0 : open(engine))};
+}
+
+// A cut is a point between values, where {x, false} is just below x and {x, true} is just above
+// it. An interval holds the values between its lower cut and its upper cut.
+template <typename T>
+std::pair<T, bool> lower_cut(ez::interval<T> const& r) {
+	return {r.lower(), r.left_open()};
+}
+
+template <typename T>
+std::pair<T, bool> upper_cut(ez::interval<T> const& r) {
+	return {r.upper(), r.right_closed()};
+}
+
+// Returns true if a and b have at least one value in common
+template <typename T>
+bool overlaps(ez::interval<T> const& a, ez::interval<T> const& b) {
+	return lower_cut(a) < upper_cut(b) && lower_cut(b) < upper_cut(a);
+}
+
+}
+
+#endif
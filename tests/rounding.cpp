@@ -0,0 +1,85 @@
+#include "ez/rounding.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cfenv>
+#include <cmath>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(rounding)
+
+BOOST_AUTO_TEST_CASE(RestoresMode) {
+	BOOST_REQUIRE_EQUAL(std::fegetround(), FE_TONEAREST);
+	{
+		ez::outward_rounding rounding;
+		BOOST_CHECK_EQUAL(std::fegetround(), FE_UPWARD);
+	}
+	BOOST_CHECK_EQUAL(std::fegetround(), FE_TONEAREST);
+}
+
+BOOST_AUTO_TEST_CASE(Encloses) {
+	auto const a = ez::make_interval[0.1][0.1];
+	auto const b = ez::make_interval(0.2)[0.2 + 1e-9];
+	auto const three = ez::make_interval[3.0][3.0];
+	auto const nearest_sum = 0.1 + 0.2;
+	auto const nearest_difference = 0.1 - 0.2;
+	auto const nearest_product = 0.1 * 3.0;
+	auto const nearest_quotient = 0.1 / 3.0;
+
+	ez::outward_rounding rounding;
+	auto const sum = rounding.add(a, b);
+	BOOST_CHECK(sum.lower() <= nearest_sum && nearest_sum <= sum.upper());
+	BOOST_CHECK(sum.lower() < sum.upper());
+	BOOST_CHECK(sum.left_open());
+	BOOST_CHECK(sum.right_closed());
+
+	auto const difference = rounding.subtract(a, b);
+	BOOST_CHECK(difference.lower() <= nearest_difference);
+	BOOST_CHECK(difference.upper() >= nearest_difference);
+	BOOST_CHECK(difference.left_closed());
+	BOOST_CHECK(difference.right_open());
+
+	auto const product = rounding.multiply(a, three);
+	BOOST_CHECK_EQUAL(std::nextafter(product.lower(), 1.0), product.upper());
+	BOOST_CHECK(product.lower() <= nearest_product && nearest_product <= product.upper());
+
+	auto const negative = rounding.multiply(a, ez::make_interval[-3.0][-3.0]);
+	BOOST_CHECK_EQUAL(negative.lower(), -product.upper());
+	BOOST_CHECK_EQUAL(negative.upper(), -product.lower());
+
+	auto const quotient = rounding.divide(a, three);
+	BOOST_CHECK_EQUAL(std::nextafter(quotient.lower(), 1.0), quotient.upper());
+	BOOST_CHECK(quotient.lower() <= nearest_quotient && nearest_quotient <= quotient.upper());
+
+	BOOST_CHECK_THROW(rounding.divide(a, ez::make_interval(0.0)[1.0]), ez::divide_by_zero);
+}
+
+BOOST_AUTO_TEST_CASE(ExactMatchesOperators) {
+	// With small integers nothing is rounded, so the results are the same as the operators
+	std::vector<ez::interval<double>> intervals;
+	for(auto lower : {-3.0, -1.0, 0.0, 2.0}) {
+		for(auto upper : {-1.0, 0.0, 2.0, 5.0}) {
+			for(auto o : {ez::closed, ez::left_open, ez::right_open, ez::open}) {
+				if(lower < upper) {
+					intervals.push_back(ez::interval<double>{lower, upper, o});
+				}
+			}
+		}
+	}
+
+	for(auto const& l : intervals) {
+		for(auto const& r : intervals) {
+			ez::interval<double> add = l + r;
+			ez::interval<double> subtract = l - r;
+			ez::interval<double> multiply = l * r;
+
+			ez::outward_rounding rounding;
+			BOOST_CHECK_EQUAL(rounding.add(l, r), add);
+			BOOST_CHECK_EQUAL(rounding.subtract(l, r), subtract);
+			BOOST_CHECK_EQUAL(rounding.multiply(l, r), multiply);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
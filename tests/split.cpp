@@ -0,0 +1,162 @@
+#include "ez/split.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Checks that the parts cover [0, 100] with every value in exactly one part
+template <typename Range>
+void check_cover(ez::interval<int> const& whole, Range const& parts) {
+	for(auto i : ez::make_interval[-1][101]) {
+		auto const count = std::count_if(parts.begin(), parts.end(),
+		                                 [i](ez::interval<int> const& p){ return contains(p, i); });
+		BOOST_CHECK_EQUAL(count, contains(whole, i) ? 1 : 0);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(split)
+
+BOOST_AUTO_TEST_CASE(Split) {
+	{
+		auto const parts = ez::split(ez::make_interval(0)[10], 3);
+		BOOST_REQUIRE_EQUAL(parts.size(), 3);
+		BOOST_CHECK_EQUAL(parts[0], ez::make_interval(0)(5));
+		BOOST_CHECK_EQUAL(parts[1], ez::make_interval[5](8));
+		BOOST_CHECK_EQUAL(parts[2], ez::make_interval[8][10]);
+		BOOST_CHECK_EQUAL(parts.front(), parts[0]);
+		BOOST_CHECK_EQUAL(parts.back(), parts[2]);
+
+		std::vector<ez::interval<int>> vec(parts.begin(), parts.end());
+		BOOST_CHECK(std::equal(vec.begin(), vec.end(), parts.begin()));
+		BOOST_CHECK_EQUAL(*(parts.end() - 1), parts[2]);
+		BOOST_CHECK_EQUAL(parts.begin()[1], parts[1]);
+	}
+
+	BOOST_CHECK_EQUAL(ez::split(ez::make_interval[0][10], 1)[0], ez::make_interval[0][10]);
+	BOOST_CHECK_EQUAL(ez::split(ez::make_interval(0)(10), 1)[0], ez::make_interval(0)(10));
+
+	{
+		auto const parts = ez::split(ez::make_interval[0](4), 4);
+		for(auto i : ez::make_interval[0](4)) {
+			BOOST_CHECK_EQUAL(parts[i], ez::make_interval[i](i + 1));
+		}
+	}
+
+	for(auto openness : {ez::closed, ez::left_open, ez::right_open, ez::open}) {
+		ez::interval<int> const whole{0, 100, openness};
+		for(std::ptrdiff_t n : {std::ptrdiff_t(1), std::ptrdiff_t(2), std::ptrdiff_t(3),
+	                         std::ptrdiff_t(7), std::ptrdiff_t(50), whole.size()}) {
+			auto const parts = ez::split(whole, n);
+			check_cover(whole, parts);
+
+			auto const smallest = std::min_element(parts.begin(), parts.end(),
+			  [](ez::interval<int> const& a, ez::interval<int> const& b){ return a.size() < b.size(); });
+			auto const largest = std::max_element(parts.begin(), parts.end(),
+			  [](ez::interval<int> const& a, ez::interval<int> const& b){ return a.size() < b.size(); });
+			BOOST_CHECK(largest->size() - smallest->size() <= 1);
+		}
+	}
+
+	BOOST_CHECK_THROW(ez::split(ez::make_interval[0](4), 0), ez::invalid_partition);
+	BOOST_CHECK_THROW(ez::split(ez::make_interval[0](4), 5), ez::invalid_partition);
+	BOOST_CHECK_THROW(ez::split(ez::make_interval(0)(4), 4), ez::invalid_partition);
+}
+
+BOOST_AUTO_TEST_CASE(SplitFloatingPoint) {
+	auto const parts = ez::split(ez::make_interval(0.0)[1.0], 4);
+	BOOST_REQUIRE_EQUAL(parts.size(), 4);
+	BOOST_CHECK_EQUAL(parts[0], ez::make_interval(0.0)(0.25));
+	BOOST_CHECK_EQUAL(parts[1], ez::make_interval[0.25](0.5));
+	BOOST_CHECK_EQUAL(parts[2], ez::make_interval[0.5](0.75));
+	BOOST_CHECK_EQUAL(parts[3], ez::make_interval[0.75][1.0]);
+
+	// A singleton can only be split into one part
+	BOOST_CHECK_EQUAL(ez::split(ez::make_interval[1.0][1.0], 1)[0], ez::make_interval[1.0][1.0]);
+	BOOST_CHECK_THROW(ez::split(ez::make_interval[1.0][1.0], 2), ez::invalid_partition);
+
+	// An interval a few denormals wide has too few values between its bounds for the seams
+	auto const denormal = std::numeric_limits<double>::denorm_min();
+	BOOST_CHECK_THROW(ez::split(ez::make_interval[0.0](2 * denormal), 4), ez::invalid_partition);
+	BOOST_CHECK_THROW(ez::split(ez::make_interval(0.0)(1e-323), 4), ez::invalid_partition);
+	auto const narrow = ez::split(ez::make_interval[0.0](4 * denormal), 4);
+	for(auto const& part : narrow) {
+		BOOST_CHECK_EQUAL(diameter(part), denormal);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(SplitIterators) {
+	std::vector<int> vec(10);
+	auto const parts = ez::split(ez::iterate(vec), 3);
+	BOOST_CHECK(parts[0].lower() == vec.begin());
+	BOOST_CHECK(parts[0].upper() == vec.begin() + 4);
+	BOOST_CHECK(parts[2].upper() == vec.end());
+	BOOST_CHECK(parts[2].right_open());
+}
+
+BOOST_AUTO_TEST_CASE(SplitWeighted) {
+	{
+		std::vector<ez::interval<int>> parts;
+		ez::split_weighted(ez::make_interval[0](12), std::vector<int>{1, 2, 1},
+		                   std::back_inserter(parts));
+		BOOST_REQUIRE_EQUAL(parts.size(), 3u);
+		BOOST_CHECK_EQUAL(parts[0], ez::make_interval[0](3));
+		BOOST_CHECK_EQUAL(parts[1], ez::make_interval[3](9));
+		BOOST_CHECK_EQUAL(parts[2], ez::make_interval[9](12));
+	}
+
+	{
+		// Every part gets at least one element
+		std::vector<ez::interval<int>> parts;
+		double const weights[] = {1000.0, 0.001, 0.001};
+		ez::split_weighted(ez::make_interval(0)[5], weights, std::back_inserter(parts));
+		BOOST_REQUIRE_EQUAL(parts.size(), 3u);
+		BOOST_CHECK_EQUAL(parts[0], ez::make_interval(0)(4));
+		BOOST_CHECK_EQUAL(parts[1], ez::make_interval[4](5));
+		BOOST_CHECK_EQUAL(parts[2], ez::make_interval[5][5]);
+	}
+
+	for(auto openness : {ez::closed, ez::left_open, ez::right_open, ez::open}) {
+		ez::interval<int> const whole{0, 100, openness};
+		std::vector<ez::interval<int>> parts;
+		ez::split_weighted(whole, std::vector<int>{5, 1, 3, 8, 2, 2}, std::back_inserter(parts));
+		BOOST_CHECK_EQUAL(parts.size(), 6u);
+		check_cover(whole, parts);
+	}
+
+	{
+		std::vector<ez::interval<double>> parts;
+		ez::split_weighted(ez::make_interval[0.0](8.0), std::vector<double>{1.0, 3.0},
+		                   std::back_inserter(parts));
+		BOOST_REQUIRE_EQUAL(parts.size(), 2u);
+		BOOST_CHECK_EQUAL(parts[0], ez::make_interval[0.0](2.0));
+		BOOST_CHECK_EQUAL(parts[1], ez::make_interval[2.0](8.0));
+	}
+
+	std::vector<ez::interval<int>> parts;
+	auto out = std::back_inserter(parts);
+	BOOST_CHECK_THROW(ez::split_weighted(ez::make_interval[0](4), std::vector<int>{}, out),
+	                  ez::invalid_partition);
+	BOOST_CHECK_THROW(ez::split_weighted(ez::make_interval[0](4), std::vector<int>{1, 0}, out),
+	                  ez::invalid_partition);
+	BOOST_CHECK_THROW(ez::split_weighted(ez::make_interval[0](2), std::vector<int>{1, 1, 1}, out),
+	                  ez::invalid_partition);
+	BOOST_CHECK(parts.empty());
+
+	std::vector<ez::interval<double>> float_parts;
+	auto float_out = std::back_inserter(float_parts);
+	BOOST_CHECK_THROW(ez::split_weighted(ez::make_interval[1.0][1.0], std::vector<int>{1, 1},
+	                                     float_out), ez::invalid_partition);
+	BOOST_CHECK_THROW(ez::split_weighted(ez::make_interval[0.0](1e-323), std::vector<int>{1, 1000},
+	                                     float_out), ez::invalid_partition);
+	BOOST_CHECK(float_parts.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#include "ez/static_interval_index.hpp"
+#include "ostream.hpp"
+#include "random_interval.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(static_interval_index)
+
+BOOST_AUTO_TEST_CASE(Queries) {
+	ez::static_interval_index<int> const empty;
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK(!empty.contains(0));
+
+	ez::static_interval_index<int> const index = {ez::make_interval[0](10),
+	                                              ez::make_interval(5)[20],
+	                                              ez::make_interval[30][30]};
+	BOOST_CHECK_EQUAL(index.size(), 3u);
+	BOOST_CHECK(index.contains(0));
+	BOOST_CHECK(index.contains(20));
+	BOOST_CHECK(!index.contains(25));
+	BOOST_CHECK(index.contains(30));
+	BOOST_CHECK(!index.contains(31));
+
+	std::size_t found[3];
+	auto end = index.containing(7, found);
+	BOOST_REQUIRE_EQUAL(end - found, 2);
+	BOOST_CHECK_EQUAL(found[0], 0u);
+	BOOST_CHECK_EQUAL(found[1], 1u);
+
+	end = index.containing(5, found);
+	BOOST_REQUIRE_EQUAL(end - found, 1);
+	BOOST_CHECK_EQUAL(found[0], 0u);
+
+	end = index.overlapping(ez::make_interval(10)[30], found);
+	BOOST_REQUIRE_EQUAL(end - found, 2);
+	BOOST_CHECK_EQUAL(found[0], 1u);
+	BOOST_CHECK_EQUAL(found[1], 2u);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesBruteForce) {
+	std::mt19937 engine{13};
+	for(std::size_t n = 0; n < 70; ++n) {
+		std::vector<ez::interval<int>> intervals;
+		for(std::size_t i = 0; i < n; ++i) {
+			intervals.push_back(test::random_interval<int>(engine, 40));
+		}
+		ez::static_interval_index<int> const index(intervals.begin(), intervals.end());
+		BOOST_REQUIRE_EQUAL(index.size(), n);
+
+		for(int x = -1; x <= 41; ++x) {
+			std::vector<std::size_t> expected;
+			for(std::size_t i = 0; i < n; ++i) {
+				if(contains(intervals[i], x)) {
+					expected.push_back(i);
+				}
+			}
+			BOOST_CHECK_EQUAL(index.contains(x), !expected.empty());
+
+			std::vector<std::size_t> actual;
+			index.containing(x, std::back_inserter(actual));
+			std::sort(actual.begin(), actual.end());
+			BOOST_CHECK(actual == expected);
+		}
+
+		for(int round = 0; round < 20; ++round) {
+			auto const query = test::random_interval<int>(engine, 40);
+			std::vector<std::size_t> expected;
+			for(std::size_t i = 0; i < n; ++i) {
+				if(test::overlaps(intervals[i], query)) {
+					expected.push_back(i);
+				}
+			}
+			std::vector<std::size_t> actual;
+			index.overlapping(query, std::back_inserter(actual));
+			std::sort(actual.begin(), actual.end());
+			BOOST_CHECK(actual == expected);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
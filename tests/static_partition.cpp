@@ -0,0 +1,72 @@
+#include "ez/static_partition.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+
+typedef ez::static_partition<int, 100, 200, 300, 400, 500, 600> status_classes;
+
+static_assert(status_classes::size() == 5, "");
+static_assert(status_classes::find(99) == 5, "");
+static_assert(status_classes::find(100) == 0, "");
+static_assert(status_classes::find(404) == 3, "");
+static_assert(status_classes::find(599) == 4, "");
+static_assert(status_classes::find(600) == 5, "");
+static_assert(status_classes::interval(1).lower() == 200, "");
+static_assert(status_classes::interval(1).upper() == 300, "");
+
+// The interval types and contains work in constant expressions
+constexpr ez::closed_interval<int> digits{0, 9};
+static_assert(contains(digits, 9) && !contains(digits, 10), "");
+static_assert(!contains(ez::open_interval<int>{0, 9}, 0), "");
+static_assert(*ez::make_direct_iterator(3) == 3, "");
+static_assert(ez::make_direct_iterator(3) < ez::make_direct_iterator(4), "");
+
+struct name_bucket {
+	template <std::size_t I>
+	char const* operator()(std::integral_constant<std::size_t, I>) const {
+		return I == 0 ? "control" : I == 1 ? "printable" : "other";
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(static_partition)
+
+BOOST_AUTO_TEST_CASE(MatchesContains) {
+	typedef ez::static_partition<std::int16_t, -5, 0, 1, 7, 20, 21, 50, 51, 52, 100> partition;
+	BOOST_CHECK_EQUAL(partition::size(), 9u);
+	for(std::int16_t x = -10; x < 110; ++x) {
+		auto expected = partition::size();
+		for(std::size_t i = 0; i < partition::size(); ++i) {
+			if(contains(partition::interval(i), x)) {
+				expected = i;
+			}
+		}
+		BOOST_CHECK_EQUAL(partition::find(x), expected);
+		BOOST_CHECK_EQUAL(partition::dispatch(x, [](std::size_t i){ return i; }), expected);
+	}
+
+	typedef ez::static_partition<int, 0, 1> single;
+	BOOST_CHECK_EQUAL(single::find(-1), 1u);
+	BOOST_CHECK_EQUAL(single::find(0), 0u);
+	BOOST_CHECK_EQUAL(single::find(1), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(Dispatch) {
+	typedef ez::static_partition<unsigned char, 0, 32, 127> ascii;
+	BOOST_CHECK_EQUAL(ascii::dispatch('\n', name_bucket{}), "control");
+	BOOST_CHECK_EQUAL(ascii::dispatch('a', name_bucket{}), "printable");
+	BOOST_CHECK_EQUAL(ascii::dispatch(200, name_bucket{}), "other");
+}
+
+BOOST_AUTO_TEST_CASE(EmptyIntervalStillThrows) {
+	BOOST_CHECK_THROW((ez::closed_interval<int>{1, 0}), ez::empty_interval);
+	BOOST_CHECK_THROW((ez::open_interval<int>{0, 0}), ez::empty_interval);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
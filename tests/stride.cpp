@@ -0,0 +1,89 @@
+#include "ez/stride.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <typename Range>
+std::vector<typename Range::type> to_vector(Range const& r) {
+	return {r.begin(), r.end()};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(stride)
+
+BOOST_AUTO_TEST_CASE(TypeChecks) {
+	typedef ez::strided_iterator<int> iterator;
+	static_assert(std::is_same<std::random_access_iterator_tag,
+	                           iterator::iterator_category>::value, "");
+	static_assert(std::is_same<int const&, decltype(*std::declval<iterator>())>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(Stride) {
+	BOOST_CHECK((to_vector(ez::stride(ez::make_interval[0](10), 4)) == std::vector<int>{0, 4, 8}));
+	BOOST_CHECK((to_vector(ez::stride(ez::make_interval[0][8], 4)) == std::vector<int>{0, 4, 8}));
+	BOOST_CHECK((to_vector(ez::stride(ez::make_interval(0)[8], 4)) == std::vector<int>{1, 5}));
+	BOOST_CHECK((to_vector(ez::stride(ez::make_interval(0)(1), 2)) == std::vector<int>{}));
+	BOOST_CHECK((to_vector(ez::stride(ez::make_interval[3][3], 2)) == std::vector<int>{3}));
+
+	BOOST_CHECK_EQUAL(ez::stride(ez::make_interval[0](10), 1).size(), 10);
+	BOOST_CHECK_EQUAL(ez::stride(ez::make_interval[0](10), 3).size(), 4);
+	BOOST_CHECK_EQUAL(ez::stride(ez::make_interval[0](10), 10).size(), 1);
+	BOOST_CHECK_EQUAL(ez::stride(ez::make_interval[0](10), 11).size(), 1);
+
+	auto const A = ez::stride(ez::interval<int>{0, 10, ez::right_open}, 2);
+	BOOST_CHECK((to_vector(ez::stride(A, 2)) == std::vector<int>{0, 4, 8}));
+	BOOST_CHECK_EQUAL(A.end() - A.begin(), A.size());
+	BOOST_CHECK_EQUAL(A.begin()[3], 6);
+	BOOST_CHECK_EQUAL(*(A.begin() + 4), 8);
+	BOOST_CHECK_EQUAL(A.back(), 8);
+
+	BOOST_CHECK_THROW(ez::stride(ez::make_interval[0](10), 0), ez::invalid_stride);
+	BOOST_CHECK_THROW(ez::stride(ez::make_interval[0](10), -1), ez::invalid_stride);
+	BOOST_CHECK_THROW(ez::stride(A, 0), ez::invalid_stride);
+
+	std::vector<int> vec(7);
+	std::vector<std::size_t> indices;
+	for(auto i : ez::stride(ez::indices(vec), 3)) {
+		indices.push_back(i);
+	}
+	BOOST_CHECK((indices == std::vector<std::size_t>{0, 3, 6}));
+}
+
+BOOST_AUTO_TEST_CASE(Reversed) {
+	BOOST_CHECK((to_vector(ez::reversed(ez::make_interval(0)[3])) == std::vector<int>{3, 2, 1}));
+	BOOST_CHECK((to_vector(ez::reversed(ez::make_interval[0](3))) == std::vector<int>{2, 1, 0}));
+	BOOST_CHECK((to_vector(ez::reversed(ez::make_interval(0)(1))) == std::vector<int>{}));
+
+	auto const A = ez::stride(ez::make_interval[0](10), 4);
+	BOOST_CHECK((to_vector(ez::reversed(A)) == std::vector<int>{8, 4, 0}));
+	BOOST_CHECK((to_vector(ez::reversed(ez::reversed(A))) == std::vector<int>{0, 4, 8}));
+	BOOST_CHECK((to_vector(ez::stride(ez::reversed(A), 2)) == std::vector<int>{8, 0}));
+
+	std::vector<unsigned> vec = {1, 2, 3};
+	std::vector<unsigned> rev;
+	for(auto i : ez::reversed(ez::indices(vec))) {
+		rev.push_back(vec[i]);
+	}
+	BOOST_CHECK((rev == std::vector<unsigned>{3, 2, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(Limits) {
+	auto const max = std::numeric_limits<int>::max();
+	auto const min = std::numeric_limits<int>::min();
+
+	BOOST_CHECK((to_vector(ez::stride(ez::make_interval[max - 4][max], 2)) ==
+	             std::vector<int>{max - 4, max - 2, max}));
+	BOOST_CHECK((to_vector(ez::reversed(ez::make_interval[min][min + 2])) ==
+	             std::vector<int>{min + 2, min + 1, min}));
+	BOOST_CHECK_EQUAL(ez::stride(ez::make_interval[min][max], 1 << 16).size(), 1 << 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
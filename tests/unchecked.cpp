@@ -0,0 +1,58 @@
+#include "ez/unchecked.hpp"
+#include "ostream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace {
+
+// The unchecked constructors and functions are constexpr like the checked ones
+constexpr ez::closed_interval<int> digits{0, 9, ez::unchecked};
+static_assert(digits.upper() == 9, "");
+static_assert(ez::unchecked_add(digits, digits).upper() == 18, "");
+static_assert(ez::unchecked_sub(digits, 2).lower() == -2, "");
+
+}
+
+BOOST_AUTO_TEST_SUITE(unchecked)
+
+BOOST_AUTO_TEST_CASE(ConstructAndAssign) {
+	ez::ropen_interval<int> a{0, 3, ez::unchecked};
+	BOOST_CHECK_EQUAL(a, ez::make_interval[0](3));
+	a.assign(2, 5, ez::unchecked);
+	BOOST_CHECK_EQUAL(a, ez::make_interval[2](5));
+
+	ez::interval<double> b{1.0, 2.0, true, false, ez::unchecked};
+	BOOST_CHECK_EQUAL(b, ez::make_interval(1.0)[2.0]);
+	b.assign(-1.0, 0.0, ez::unchecked);
+	BOOST_CHECK_EQUAL(b, ez::make_interval(-1.0)[0.0]);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesOperators) {
+	std::vector<ez::closed_interval<int>> const closed = {
+	  ez::make_interval[-3][-1], ez::make_interval[-2][4], ez::make_interval[0][0],
+	  ez::make_interval[1][5]
+	};
+	for(auto const& l : closed) {
+		for(auto const& r : closed) {
+			BOOST_CHECK_EQUAL(ez::unchecked_add(l, r), l + r);
+			BOOST_CHECK_EQUAL(ez::unchecked_sub(l, r), l - r);
+			BOOST_CHECK_EQUAL(ez::unchecked_mul(l, r), l * r);
+			if(!contains(r, 0)) {
+				BOOST_CHECK_EQUAL(ez::unchecked_div(l, r), l / r);
+			}
+		}
+		BOOST_CHECK_EQUAL(ez::unchecked_add(l, 3), l + 3);
+		BOOST_CHECK_EQUAL(ez::unchecked_sub(l, 3), l - 3);
+		BOOST_CHECK_EQUAL(ez::unchecked_mul(l, 2), l * 2);
+		BOOST_CHECK_EQUAL(ez::unchecked_div(l, 2), l / 2);
+	}
+
+	auto const a = ez::make_interval(0.5)(2.0);
+	auto const b = ez::make_interval(-4.0)(-1.0);
+	BOOST_CHECK_EQUAL(ez::unchecked_mul(a, b), a * b);
+	BOOST_CHECK_EQUAL(ez::unchecked_div(a, b), a / b);
+}
+
+BOOST_AUTO_TEST_SUITE_END()